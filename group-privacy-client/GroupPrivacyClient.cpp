@@ -40,9 +40,10 @@ int main(int argc, char* argv[])
     const std::string DEFAULT_PORT = "31337";
     std::string host = (argc > 1 ? std::string(argv[1]) : DEFAULT_HOST);
     std::string port = (argc > 2 ? std::string(argv[2]) : DEFAULT_PORT);
+    bool offline = (argc > 3 && std::string(argv[3]) == "offline");
     try
     {
-        GroupPrivacyClientManager groupPrivacyClientManager(host, port);
+        GroupPrivacyClientManager groupPrivacyClientManager(host, port, offline);
         groupPrivacyClientManager.manage();
     }
     catch(std::exception& e)
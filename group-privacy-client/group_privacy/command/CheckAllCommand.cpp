@@ -0,0 +1,101 @@
+/**
+ * @file CheckAllCommand.cpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains definitions of the methods from
+ * \c CheckAllCommand class.
+ */
+
+#include "CheckAllCommand.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+CheckAllCommand::CheckAllCommand(boost::shared_ptr<GroupPrivacyClient> client)
+    : ICommand(client)
+{
+}
+
+Signature CheckAllCommand::determineSignature()
+{
+    std::string signatureFilename;
+    std::cin >> signatureFilename;
+    if(!fileExists(signatureFilename))
+        throw std::runtime_error("File \'" + signatureFilename + "\' doesn't exist!");
+    return Utils::deserialize<Signature>(getFileContent(signatureFilename));
+}
+
+void CheckAllCommand::execute()
+{
+    std::cout << "CheckAllCommand::execute() started" << std::endl;
+    try
+    {
+        Signature signature = determineSignature();
+        client->loadParameters();
+        const std::vector<GroupPrivacyClient::CheckedUser> users = client->checkAll(signature);
+        std::cout << users.size() << " users have published necessary data." << std::endl;
+        printUsers("Authors of the signature:", users, CheckContext::SIGNER);
+        printUsers("Not authors of the signature:", users, CheckContext::NOT_SIGNER);
+        printUsers("Probably cheating because their data is not real:", users, CheckContext::CHEATER);
+        printUsers("Couldn't be checked because of an error:", users, CheckContext::UNKNOWN);
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+    std::cout << "CheckAllCommand::execute() finished" << std::endl;
+}
+
+bool CheckAllCommand::fileExists(const std::string& filename)
+{
+    std::ifstream file(filename.c_str());
+    return file.is_open();
+}
+
+std::string CheckAllCommand::getFileContent(const std::string& filename)
+{
+    std::ifstream file(filename.c_str());
+    std::ostringstream oss;
+    oss << file.rdbuf();
+    return oss.str();
+}
+
+void CheckAllCommand::printUsers(const std::string& title,
+                                 const std::vector<GroupPrivacyClient::CheckedUser>& users,
+                                 const CheckContext::Result result)
+{
+    std::cout << title;
+    bool found = false;
+    for(std::size_t i = 0; i < users.size(); ++i)
+    {
+        if(users[i].second == result)
+        {
+            std::cout << " " << users[i].first;
+            found = true;
+        }
+    }
+    std::cout << (found ? "" : " none") << std::endl;
+}
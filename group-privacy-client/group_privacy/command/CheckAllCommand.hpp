@@ -0,0 +1,108 @@
+/**
+ * @file CheckAllCommand.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains CheckAllCommand class which is responsible
+ * for interaction between a user and the system during
+ * checking all users who have published data for a signature.
+ */
+
+#ifndef CHECKALLCOMMAND_HPP
+#define	CHECKALLCOMMAND_HPP
+
+#include "../step_out_group_signatures/CheckContext.hpp"
+#include "../step_out_group_signatures/Signature.hpp"
+#include "ICommand.hpp"
+
+#include <boost/shared_ptr.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * CheckAllCommand class.
+ *
+ * Implements ICommand interface. It receives data published
+ * by all users for a signature in one response, checks all
+ * of them in parallel and prints who is an author of the signature,
+ * who isn't, who probably cheats and who couldn't be checked.
+ */
+class CheckAllCommand : public ICommand
+{
+public:
+    /**
+     * Constructor of the CheckAllCommand class.
+     *
+     * Creates an instance of the class.
+     * @param client Client which performs procedures of the scheme.
+     */
+    CheckAllCommand(boost::shared_ptr<GroupPrivacyClient> client);
+
+    /**
+     * Supports a user during checking all users at once.
+     */
+    void execute();
+private:
+    /**
+     * Gets from standart input a name of a file which contains
+     * step-out group signature, deserializes the file's content
+     * and return the signature.
+     *
+     * @return Step-out group signature.
+     *
+     * @throws std::runtime_error Thrown when the provided file doesn't exist.
+     */
+    Signature determineSignature();
+
+    /**
+     * Checks whether a file of a given name exists.
+     *
+     * @param filename Name of a file.
+     * @return True if the file exists. False otherwise.
+     */
+    bool fileExists(const std::string& filename);
+
+    /**
+     * Extracts content of a given file.
+     *
+     * @param filename Name of a file.
+     * @return Content of the file.
+     */
+    std::string getFileContent(const std::string& filename);
+
+    /**
+     * Prints index numbers of users with a given result of the check.
+     *
+     * @param title Description of the users.
+     * @param users Index numbers and results of all checked users.
+     * @param result Result of the users to print.
+     */
+    void printUsers(const std::string& title,
+                    const std::vector<GroupPrivacyClient::CheckedUser>& users,
+                    const CheckContext::Result result);
+};
+
+#endif // CHECKALLCOMMAND_HPP
@@ -30,7 +30,7 @@
 
 #include "CheckCommand.hpp"
 
-#include <boost/lexical_cast.hpp>
+#include "SerializationUtils.hpp"
 
 #include <fstream>
 #include <iostream>
@@ -38,9 +38,8 @@
 #include <stdexcept>
 #include <string>
 
-CheckCommand::CheckCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket),
-      stepOutGroupSignaturesClientManager(StepOutGroupSignaturesClientManager::instance())
+CheckCommand::CheckCommand(boost::shared_ptr<GroupPrivacyClient> client)
+    : ICommand(client)
 {
 }
 
@@ -67,17 +66,10 @@ void CheckCommand::execute()
     {
         Signature signature = determineSignature();
         unsigned int userIndex = determineUserIndex();
-        send(std::string("check"));
-        receive<std::string>(); // OK status
-        send(stepOutGroupSignaturesClientManager.createCheckProcedureInput(userIndex, signature));
-        if(receive<std::string>() == "yes")
-        {
-            send(std::string("ok"));
-            UserPublicKey userPublicKey = receive<UserPublicKey>();
-            send(std::string("ok"));
-            PublishedValues publishedValues = receive<PublishedValues>();
-            checkUser(userIndex, userPublicKey, publishedValues, signature);
-        }
+        client->loadParameters();
+        const boost::optional<CheckContext::Result> result = client->check(userIndex, signature);
+        if(result)
+            printResult(userIndex, *result);
         else
         {
             std::cout << "User " << userIndex << " hasn't published necessary data." << std::endl;
@@ -147,16 +139,21 @@ std::string CheckCommand::getFileContent(const std::string& filename)
     return oss.str();
 }
 
-void CheckCommand::checkUser(const unsigned int userIndex,
-                             const UserPublicKey& userPublicKey,
-                             const PublishedValues& publishedValues,
-                             const Signature& signature)
+void CheckCommand::printResult(const unsigned int userIndex, const CheckContext::Result result)
 {
     std::cout << "User " << userIndex << " has published necessary data." << std::endl;
-    if(stepOutGroupSignaturesClientManager.isSigner(userPublicKey, publishedValues, signature))
-        std::cout << "He is an author of the signature." << std::endl;
-    else if(stepOutGroupSignaturesClientManager.isNotSigner(userPublicKey, publishedValues, signature))
-        std::cout << "He is not an author of the signature." << std::endl;
-    else
-        std::cout << "However he probably cheats because the data is not real." << std::endl;
+    switch(result)
+    {
+        case CheckContext::SIGNER:
+            std::cout << "He is an author of the signature." << std::endl;
+            break;
+        case CheckContext::NOT_SIGNER:
+            std::cout << "He is not an author of the signature." << std::endl;
+            break;
+        case CheckContext::UNKNOWN:
+            std::cout << "However it couldn't be checked because of an error." << std::endl;
+            break;
+        default:
+            std::cout << "However he probably cheats because the data is not real." << std::endl;
+    }
 }
@@ -32,13 +32,10 @@
 #ifndef CHECKCOMMAND_HPP
 #define	CHECKCOMMAND_HPP
 
-#include "../step_out_group_signatures/PublishedValues.hpp"
+#include "../step_out_group_signatures/CheckContext.hpp"
 #include "../step_out_group_signatures/Signature.hpp"
-#include "../step_out_group_signatures/StepOutGroupSignaturesClientManager.hpp"
-#include "../step_out_group_signatures/UserPublicKey.hpp"
 #include "ICommand.hpp"
 
-#include <boost/asio.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include <stdexcept>
@@ -58,26 +55,15 @@ public:
      * Constructor of the CheckCommand class.
      *
      * Creates an instance of the class.
-     * @param socket Socket used to comunicate with the Group Privacy Server.
+     * @param client Client which performs procedures of the scheme.
      */
-    CheckCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
+    CheckCommand(boost::shared_ptr<GroupPrivacyClient> client);
 
     /**
      * Supports a user during the proof and the step-out procedure.
      */
     void execute();
 private:
-    /**
-     * Checks whether a group member is an author
-     * of a step-out group signature.
-     *
-     * @param userPublicKey
-     */
-    void checkUser(const unsigned int userIndex,
-                   const UserPublicKey& userPublicKey,
-                   const PublishedValues& publishedValues,
-                   const Signature& signature);
-
     /**
      * Gets from standart input a name of a file which contains
      * step-out group signature, deserializes the file's content
@@ -112,7 +98,14 @@ private:
      */
     std::string getFileContent(const std::string& filename);
 
-    StepOutGroupSignaturesClientManager& stepOutGroupSignaturesClientManager; /**< Manager which implements scheme algorithms. */
+    /**
+     * Prints whether a group member is an author
+     * of a step-out group signature.
+     *
+     * @param userIndex Index number of the member.
+     * @param result Result of checking the member.
+     */
+    void printResult(const unsigned int userIndex, const CheckContext::Result result);
 };
 
 #endif // CHECKCOMMAND_HPP
@@ -27,14 +27,11 @@
 
 #include "CloseSignatureCommand.hpp"
 
-#include "../step_out_group_signatures/CloseSignatureInput.hpp"
-
 #include <iostream>
 #include <string>
 
-CloseSignatureCommand::CloseSignatureCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket),
-      stepOutGroupSignaturesClientManager(StepOutGroupSignaturesClientManager::instance())
+CloseSignatureCommand::CloseSignatureCommand(boost::shared_ptr<GroupPrivacyClient> client)
+    : ICommand(client)
 {
 }
 
@@ -49,9 +46,13 @@ void CloseSignatureCommand::execute()
 {
     std::cout << "CloseSignatureCommand::execute() started" << std::endl;
     unsigned int signatureIndex = determineSignatureIndex();
-    send(std::string("close-signature"));
-    receive<std::string>(); // OK status
-    CloseSignatureInput input = stepOutGroupSignaturesClientManager.createCloseSignatureInput(signatureIndex);
-    send(input);
+    try
+    {
+        client->closeSignature(signatureIndex);
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
     std::cout << "CloseSignatureCommand::execute() finished" << std::endl;
 }
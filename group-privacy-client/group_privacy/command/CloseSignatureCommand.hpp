@@ -32,10 +32,8 @@
 #ifndef CLOSESIGNATURECOMMAND_HPP
 #define	CLOSESIGNATURECOMMAND_HPP
 
-#include "../step_out_group_signatures/StepOutGroupSignaturesClientManager.hpp"
 #include "ICommand.hpp"
 
-#include <boost/asio.hpp>
 #include <boost/shared_ptr.hpp>
 
 /**
@@ -53,9 +51,9 @@ public:
      *
      * Creates an instance of the class.
      *
-     * @param socket Socket used to comunicate with the Group Privacy Server.
+     * @param client Client which performs procedures of the scheme.
      */
-    CloseSignatureCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
+    CloseSignatureCommand(boost::shared_ptr<GroupPrivacyClient> client);
 
     /**
      * Supports a user during the closing procedure.
@@ -68,8 +66,6 @@ private:
      * @return Signature's ID.
      */
     unsigned int determineSignatureIndex();
-
-    StepOutGroupSignaturesClientManager& stepOutGroupSignaturesClientManager; /**< Manager which implements scheme algorithms. */
 };
 
 #endif // CLOSESIGNATURECOMMAND_HPP
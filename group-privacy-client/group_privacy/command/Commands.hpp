@@ -30,8 +30,10 @@
 #ifndef COMMANDS_HPP
 #define	COMMANDS_HPP
 
+#include "CheckAllCommand.hpp"
 #include "CheckCommand.hpp"
 #include "CloseSignatureCommand.hpp"
+#include "ExportParametersCommand.hpp"
 #include "FinalizeSignatureCommand.hpp"
 #include "GetSignatureCommand.hpp"
 #include "InitializeSignatureCommand.hpp"
@@ -40,6 +42,8 @@
 #include "QuitCommand.hpp"
 #include "RegisterCommand.hpp"
 #include "SignCommand.hpp"
+#include "StatisticsCommand.hpp"
+#include "VerifyBatchCommand.hpp"
 #include "VerifyCommand.hpp"
 
 #endif // COMMANDS_HPP
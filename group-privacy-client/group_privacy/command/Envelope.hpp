@@ -0,0 +1,180 @@
+/**
+ * @file Envelope.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains functions which encode and decode
+ * envelopes of requests and responses.
+ */
+
+#ifndef ENVELOPE_HPP
+#define	ENVELOPE_HPP
+
+#include <boost/array.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Envelopes of requests and responses.
+ *
+ * A request consists of its identifier (4 bytes, big-endian),
+ * the code of the requested operation (1 byte) and
+ * the serialized arguments.
+ *
+ * A response consists of the request's identifier (4 bytes, big-endian),
+ * a status (1 byte, 1 if the operation has succeeded) and
+ * the serialized values or an error message.
+ *
+ * Arguments and values are never copied into an envelope,
+ * they are sent right after its header.
+ */
+namespace Envelope
+{
+
+/**
+ * Codes of operations. The values are part of the protocol,
+ * so new operations have to be added at the end.
+ */
+enum Operation
+{
+    CALCULATE_PQ                  = 0,
+    CHECK                         = 1,
+    CLOSE_SIGNATURE               = 2,
+    FINALIZE_SIGNATURE            = 3,
+    GET_FINALIZE_SIGNATURE_INPUT  = 4,
+    GET_PARAMETERS                = 5,
+    GET_SIGNATURE                 = 6,
+    GET_T                         = 7,
+    INITIALIZE_SIGNATURE          = 8,
+    INITIALIZE_SIGNATURE_DIGEST   = 9,
+    JOIN_SIGNATURE                = 10,
+    PUBLISH                       = 11,
+    QUIT                          = 12,
+    REGISTER                      = 13,
+    SIGN                          = 14,
+    GET_PARAMETERS_FINGERPRINT    = 15,
+    GET_PARAMETERS_BUNDLE         = 16,
+    CHECK_ALL                     = 17,
+    NUMBER_OF_OPERATIONS          = 18
+};
+
+const std::size_t ID_SIZE              = 4;             /**< Size of a request's identifier. */
+const std::size_t REQUEST_HEADER_SIZE  = ID_SIZE + 1;   /**< Size of a request's header. */
+const std::size_t RESPONSE_HEADER_SIZE = ID_SIZE + 1;   /**< Size of a response's header. */
+
+typedef boost::array<unsigned char, REQUEST_HEADER_SIZE> RequestHeader;
+typedef boost::array<unsigned char, RESPONSE_HEADER_SIZE> ResponseHeader;
+
+inline void encodeId(const unsigned int id, unsigned char* encoded)
+{
+    for(std::size_t i = 0; i < ID_SIZE; ++i)
+        encoded[i] = static_cast<unsigned char>(id >> (8 * (ID_SIZE - 1 - i)));
+}
+
+inline unsigned int decodeId(const unsigned char* encoded)
+{
+    unsigned int id = 0;
+    for(std::size_t i = 0; i < ID_SIZE; ++i)
+        id = (id << 8) | encoded[i];
+    return id;
+}
+
+/**
+ * Encodes a request's header.
+ *
+ * @param requestId Identifier of the request.
+ * @param operation Requested operation.
+ * @return Header which precedes the request's arguments.
+ */
+inline RequestHeader encodeRequestHeader(const unsigned int requestId, const Operation operation)
+{
+    RequestHeader header;
+    encodeId(requestId, header.data());
+    header[ID_SIZE] = static_cast<unsigned char>(operation);
+    return header;
+}
+
+/**
+ * Decodes a request. The operation's code isn't checked,
+ * since it may come from a newer client.
+ *
+ * @param request Received request.
+ * @param requestId Identifier of the request.
+ * @param operation Code of the requested operation.
+ * @param arguments Serialized arguments of the operation.
+ */
+inline void decodeRequest(const std::string& request,
+                          unsigned int& requestId,
+                          unsigned int& operation,
+                          std::string& arguments)
+{
+    if(request.size() < REQUEST_HEADER_SIZE)
+        throw std::runtime_error("Malformed request received!");
+    const unsigned char* header = reinterpret_cast<const unsigned char*>(request.data());
+    requestId = decodeId(header);
+    operation = header[ID_SIZE];
+    arguments.assign(request, REQUEST_HEADER_SIZE, std::string::npos);
+}
+
+/**
+ * Encodes a response's header.
+ *
+ * @param requestId Identifier of the request.
+ * @param succeeded True if the operation has succeeded.
+ * @return Header which precedes the response's values.
+ */
+inline ResponseHeader encodeResponseHeader(const unsigned int requestId, const bool succeeded)
+{
+    ResponseHeader header;
+    encodeId(requestId, header.data());
+    header[ID_SIZE] = succeeded ? 1 : 0;
+    return header;
+}
+
+/**
+ * Decodes a response.
+ *
+ * @param response Received response.
+ * @param requestId Identifier of the request.
+ * @param succeeded True if the operation has succeeded.
+ * @param values Serialized values or an error message.
+ */
+inline void decodeResponse(const std::string& response,
+                           unsigned int& requestId,
+                           bool& succeeded,
+                           std::string& values)
+{
+    if(response.size() < RESPONSE_HEADER_SIZE)
+        throw std::runtime_error("Malformed response received!");
+    const unsigned char* header = reinterpret_cast<const unsigned char*>(response.data());
+    requestId = decodeId(header);
+    succeeded = header[ID_SIZE] != 0;
+    values.assign(response, RESPONSE_HEADER_SIZE, std::string::npos);
+}
+
+} // namespace Envelope
+
+#endif // ENVELOPE_HPP
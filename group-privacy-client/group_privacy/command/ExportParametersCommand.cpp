@@ -0,0 +1,68 @@
+/**
+ * @file ExportParametersCommand.cpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains definitions of the methods from
+ * \c ExportParametersCommand class.
+ */
+
+#include "ExportParametersCommand.hpp"
+
+#include "../step_out_group_signatures/ParametersBundle.hpp"
+#include "ParametersCache.hpp"
+#include "SerializationUtils.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+ExportParametersCommand::ExportParametersCommand(boost::shared_ptr<GroupPrivacyClient> client)
+    : ICommand(client)
+{
+}
+
+void ExportParametersCommand::execute()
+{
+    std::cout << "ExportParametersCommand::execute() started" << std::endl;
+    std::string filename;
+    std::cin >> filename;
+    try
+    {
+        const std::string serializedBundle = client->exportParameters();
+        Utils::Reader reader(serializedBundle);
+        ParametersBundle bundle;
+        reader >> bundle;
+        std::ofstream file(filename.c_str(), std::ios::binary | std::ios::trunc);
+        if(!(file << serializedBundle))
+            throw std::runtime_error("File \'" + filename + "\' couldn't be written!");
+        std::cout << "Parameters' fingerprint is " << ParametersCache::createFingerprint(bundle.getParameters())
+                  << "." << std::endl;
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+    std::cout << "ExportParametersCommand::execute() finished" << std::endl;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file ExportParametersCommand.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains ExportParametersCommand class which is responsible
+ * for interaction between a user and the system during
+ * exporting group parameters signed by the server.
+ */
+
+#ifndef EXPORTPARAMETERSCOMMAND_HPP
+#define	EXPORTPARAMETERSCOMMAND_HPP
+
+#include "ICommand.hpp"
+
+#include <boost/shared_ptr.hpp>
+
+#include <string>
+
+/**
+ * ExportParametersCommand class.
+ *
+ * Implements ICommand interface. It downloads group parameters
+ * bundled with their signature created by the server and saves
+ * them in a file, so that signatures can be verified on hosts
+ * which can't connect to the server.
+ */
+class ExportParametersCommand : public ICommand
+{
+public:
+    /**
+     * Constructor of the ExportParametersCommand class.
+     *
+     * Creates an instance of the class.
+     *
+     * @param client Client which performs procedures of the scheme.
+     */
+    ExportParametersCommand(boost::shared_ptr<GroupPrivacyClient> client);
+
+    /**
+     * Supports a user during exporting group parameters.
+     */
+    void execute();
+};
+
+#endif // EXPORTPARAMETERSCOMMAND_HPP
@@ -27,17 +27,11 @@
 
 #include "FinalizeSignatureCommand.hpp"
 
-#include "../step_out_group_signatures/FinalizeSignatureInput.hpp"
-#include "../step_out_group_signatures/FinalizeSignatureOutput.hpp"
-
-#include <boost/lexical_cast.hpp>
-
 #include <iostream>
 #include <string>
 
-FinalizeSignatureCommand::FinalizeSignatureCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket),
-      stepOutGroupSignaturesClientManager(StepOutGroupSignaturesClientManager::instance())
+FinalizeSignatureCommand::FinalizeSignatureCommand(boost::shared_ptr<GroupPrivacyClient> client)
+    : ICommand(client)
 {
 }
 
@@ -52,10 +46,13 @@ void FinalizeSignatureCommand::execute()
 {
     std::cout << "FinalizeSignatureCommand::execute() started" << std::endl;
     unsigned int signatureIndex = determineSignatureIndex();
-    send(std::string("finalize-signature"));
-    receive<std::string>(); // OK status
-    send(boost::lexical_cast<std::string>(signatureIndex));
-    FinalizeSignatureInput input = receive<FinalizeSignatureInput>();
-    send(stepOutGroupSignaturesClientManager.createFinalizeProcedureOutput(input));
+    try
+    {
+        client->finalizeSignature(signatureIndex);
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
     std::cout << "FinalizeSignatureCommand::execute() finished" << std::endl;
 }
@@ -32,10 +32,8 @@
 #ifndef FINALIZESIGNATURECOMMAND_HPP
 #define	FINALIZESIGNATURECOMMAND_HPP
 
-#include "../step_out_group_signatures/StepOutGroupSignaturesClientManager.hpp"
 #include "ICommand.hpp"
 
-#include <boost/asio.hpp>
 #include <boost/shared_ptr.hpp>
 
 /**
@@ -53,9 +51,9 @@ public:
      *
      * Creates an instance of the class.
      *
-     * @param socket Socket used to comunicate with the Group Privacy Server.
+     * @param client Client which performs procedures of the scheme.
      */
-    FinalizeSignatureCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
+    FinalizeSignatureCommand(boost::shared_ptr<GroupPrivacyClient> client);
 
     /**
      * Supports a user during finalization of a signature.
@@ -68,8 +66,6 @@ private:
      * @return Signature's ID.
      */
     unsigned int determineSignatureIndex();
-
-    StepOutGroupSignaturesClientManager& stepOutGroupSignaturesClientManager; /**< Manager which implements scheme algorithms. */
 };
 
 #endif // FINALIZESIGNATURECOMMAND_HPP
@@ -30,15 +30,12 @@
 #include "../step_out_group_signatures/Signature.hpp"
 #include "SerializationUtils.hpp"
 
-#include <boost/lexical_cast.hpp>
-
 #include <fstream>
 #include <iostream>
 #include <string>
 
-GetSignatureCommand::GetSignatureCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket),
-      stepOutGroupSignaturesClientManager(StepOutGroupSignaturesClientManager::instance())
+GetSignatureCommand::GetSignatureCommand(boost::shared_ptr<GroupPrivacyClient> client)
+    : ICommand(client)
 {
 }
 
@@ -67,10 +64,13 @@ void GetSignatureCommand::execute()
     std::cout << "GetSignatureCommand::execute() started" << std::endl;
     unsigned int signatureIndex = determineSignatureIndex();
     std::string signatureFilename = determineSignatureFilename();
-    send(std::string("get-signature"));
-    receive<std::string>(); // OK status
-    send(boost::lexical_cast<std::string>(signatureIndex));
-    Signature signature = receive<Signature>();
-    saveSignature(signatureFilename, signature);
+    try
+    {
+        saveSignature(signatureFilename, client->getSignature(signatureIndex));
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
     std::cout << "GetSignatureCommand::execute() finished" << std::endl;
 }
@@ -33,10 +33,8 @@
 #define	GETSIGNATURECOMMAND_HPP
 
 #include "../step_out_group_signatures/Signature.hpp"
-#include "../step_out_group_signatures/StepOutGroupSignaturesClientManager.hpp"
 #include "ICommand.hpp"
 
-#include <boost/asio.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include <string>
@@ -56,9 +54,9 @@ public:
      *
      * Creates an instance of the class.
      *
-     * @param socket Socket used to comunicate with the Group Privacy Server.
+     * @param client Client which performs procedures of the scheme.
      */
-    GetSignatureCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
+    GetSignatureCommand(boost::shared_ptr<GroupPrivacyClient> client);
 
     /**
      * Supports a user during downloading a signature.
@@ -86,8 +84,6 @@ private:
      * @param signature The step-out group signature.
      */
     void saveSignature(const std::string& filename, const Signature& signature);
-
-    StepOutGroupSignaturesClientManager& stepOutGroupSignaturesClientManager; /**< Manager which implements scheme algorithms. */
 };
 
 #endif // GETSIGNATURECOMMAND_HPP
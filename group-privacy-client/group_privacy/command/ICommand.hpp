@@ -32,10 +32,8 @@
 #ifndef ICOMMAND_HPP
 #define	ICOMMAND_HPP
 
-#include "SerializationUtils.hpp"
-#include "SocketManager.hpp"
+#include "../manager/GroupPrivacyClient.hpp"
 
-#include <boost/asio.hpp>
 #include <boost/shared_ptr.hpp>
 
 /**
@@ -50,9 +48,9 @@ public:
     /**
      * Constructor of the ICommand class.
      *
-     * @param socket Socket used to comunicate with the Group Privacy Server.
+     * @param client Client which performs procedures of the scheme.
      */
-    ICommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
+    ICommand(boost::shared_ptr<GroupPrivacyClient> client);
 
     /**
      * Virtual destructor of the ICommand class.
@@ -65,54 +63,12 @@ public:
      */
     virtual void execute() = 0;
 protected:
-    /**
-     * Receives data from Group Privacy Server.
-     *
-     * @return Object sent from Group Privacy Server.
-     */
-    template<typename Serializable>
-    Serializable receive();
-
-    /**
-     * Sends data to Group Privacy Server.
-     *
-     * @param serializable Object to send to Group Privacy Server.
-     */
-    template<typename Serializable>
-    void send(const Serializable& serializable);
-private:
-    SocketManager socketManager; /**< Manager used to send and receive data. */
+    boost::shared_ptr<GroupPrivacyClient> client; /**< Client which performs procedures of the scheme. */
 };
 
-inline ICommand::ICommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : socketManager(socket)
-{
-}
-
-template<typename Serializable>
-Serializable ICommand::receive()
-{
-    std::string serialized = socketManager.receive();
-    return Utils::deserialize<Serializable>(serialized);
-}
-
-template<>
-inline std::string ICommand::receive<std::string>()
-{
-    return socketManager.receive();
-}
-
-template<typename Serializable>
-void ICommand::send(const Serializable& serializable)
-{
-    std::string serialized = Utils::serialize(serializable);
-    socketManager.send(serialized);
-}
-
-template<>
-inline void ICommand::send<std::string>(const std::string& str)
+inline ICommand::ICommand(boost::shared_ptr<GroupPrivacyClient> clientInit)
+    : client(clientInit)
 {
-    socketManager.send(str);
 }
 
 #endif // ICOMMAND_HPP
@@ -27,18 +27,16 @@
 
 #include "InitializeSignatureCommand.hpp"
 
-#include "../step_out_group_signatures/InitializeSignatureInput.hpp"
-
-#include <boost/lexical_cast.hpp>
-
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <string>
 
-InitializeSignatureCommand::InitializeSignatureCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket),
-      stepOutGroupSignaturesClientManager(StepOutGroupSignaturesClientManager::instance())
+InitializeSignatureCommand::InitializeSignatureCommand(
+    boost::shared_ptr<GroupPrivacyClient> client,
+    const bool digestOnly)
+    : ICommand(client),
+      digestOnly(digestOnly)
 {
 }
 
@@ -48,6 +46,13 @@ boost::tuple<std::string, std::string> InitializeSignatureCommand::determineMess
     std::cin >> messageFilename;
     if(!fileExists(messageFilename))
         throw std::runtime_error("File \'" + messageFilename + "\' doesn't exist!");
+    if(digestOnly)
+    {
+        std::ifstream file(messageFilename.c_str(), std::ios::binary);
+        return boost::tuple<std::string, std::string>(
+            messageFilename,
+            client->createMessageDigest(file));
+    }
     return boost::tuple<std::string, std::string>(messageFilename, getFileContent(messageFilename));
 }
 
@@ -57,10 +62,15 @@ void InitializeSignatureCommand::execute()
     try
     {
         boost::tuple<std::string, std::string> message = determineMessage();
-        send(std::string("initialize-signature"));
-        receive<std::string>(); // OK status
-        send(stepOutGroupSignaturesClientManager.createInitializeSignatureInput(boost::get<1>(message)));
-        unsigned int signatureIndex = boost::lexical_cast<unsigned int>(receive<std::string>());
+        unsigned int signatureIndex;
+        try
+        {
+            signatureIndex = client->initializeSignature(boost::get<1>(message), digestOnly);
+        }
+        catch(std::runtime_error& e)
+        {
+            throw std::runtime_error(std::string("Signature wasn't initialized: ") + e.what());
+        }
         std::cout << "Assigned unique signature's number is " << signatureIndex << "." << std::endl;
     }
     catch(std::exception& e)
@@ -32,10 +32,8 @@
 #ifndef INITIALIZESIGNATURECOMMAND_HPP
 #define	INITIALIZESIGNATURECOMMAND_HPP
 
-#include "../step_out_group_signatures/StepOutGroupSignaturesClientManager.hpp"
 #include "ICommand.hpp"
 
-#include <boost/asio.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include <stdexcept>
@@ -55,9 +53,11 @@ public:
      *
      * Creates an instance of the class.
      *
-     * @param socket Socket used to comunicate with the Group Privacy Server.
+     * @param client Client which performs procedures of the scheme.
+     * @param digestOnly True if only a digest of a message should be signed
+     *                   and sent to the Group Privacy Server.
      */
-    InitializeSignatureCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
+    InitializeSignatureCommand(boost::shared_ptr<GroupPrivacyClient> client, const bool digestOnly = false);
 
     /**
      * Supports a user during downloading initialization of a signature.
@@ -67,7 +67,7 @@ private:
     /**
      * Gets from standart input a name of a file which contains
      * a message to sign and return this name and the file's
-     * content.
+     * content (or the content's digest in digest only mode).
      *
      * @return Tuple containing message's filename and content.
      *
@@ -91,7 +91,7 @@ private:
      */
     std::string getFileContent(const std::string& filename);
 
-    StepOutGroupSignaturesClientManager& stepOutGroupSignaturesClientManager; /**< Manager which implements scheme algorithms. */
+    const bool digestOnly; /**< True if a digest of a message is signed in place of the message. */
 };
 
 #endif // INITIALIZESIGNATURECOMMAND_HPP
@@ -27,16 +27,11 @@
 
 #include "JoinSignatureCommand.hpp"
 
-#include "../step_out_group_signatures/JoinSignatureInput.hpp"
-
-#include <boost/lexical_cast.hpp>
-
 #include <iostream>
 #include <string>
 
-JoinSignatureCommand::JoinSignatureCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket),
-      stepOutGroupSignaturesClientManager(StepOutGroupSignaturesClientManager::instance())
+JoinSignatureCommand::JoinSignatureCommand(boost::shared_ptr<GroupPrivacyClient> client)
+    : ICommand(client)
 {
 }
 
@@ -51,11 +46,13 @@ void JoinSignatureCommand::execute()
 {
     std::cout << "JoinSignatureCommand::execute() started" << std::endl;
     unsigned int signatureIndex = determineSignatureIndex();
-    send(std::string("join-signature"));
-    receive<std::string>(); // OK status
-    send(boost::lexical_cast<std::string>(signatureIndex));
-    BigInteger t = receive<BigInteger>();
-    JoinSignatureInput input = stepOutGroupSignaturesClientManager.createJoinSignatureInput(t);
-    send(input);
+    try
+    {
+        client->joinSignature(signatureIndex);
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
     std::cout << "JoinSignatureCommand::execute() finished" << std::endl;
 }
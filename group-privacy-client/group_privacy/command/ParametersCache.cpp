@@ -0,0 +1,204 @@
+/**
+ * @file ParametersCache.cpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains definitions of the methods from
+ * \c ParametersCache class.
+ */
+
+#include "ParametersCache.hpp"
+
+#include "../digital_signature/SigitalSignatureManager.hpp"
+#include "../hash/SHA256.hpp"
+#include "../key/RSAKey.hpp"
+#include "../step_out_group_signatures/GroupZpValues.hpp"
+#include "../step_out_group_signatures/ParametersBundle.hpp"
+#include "../step_out_group_signatures/UserPrivateKey.hpp"
+
+#include <sys/stat.h>
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+ParametersCache::ParametersCache(StepOutGroupSignaturesClientManager& manager,
+                                 const Call& call,
+                                 const std::string& filename,
+                                 const bool offline)
+    : manager(manager),
+      call(call),
+      filename(filename),
+      offline(offline),
+      validated(false)
+{
+}
+
+std::string ParametersCache::createFilename(const std::string& host, const std::string& port)
+{
+    std::string server = host + "-" + port;
+    for(std::string::iterator it = server.begin(); it != server.end(); ++it)
+    {
+        if(!std::isalnum(static_cast<unsigned char>(*it)) && *it != '.' && *it != '-')
+            *it = '_';
+    }
+    return getDirectory() + "/parameters-" + server;
+}
+
+std::string ParametersCache::createFingerprint(const std::string& parameters)
+{
+    SHA256 hasher;
+    hasher.setText(parameters);
+    const unsigned char* hash = hasher.getHash();
+    std::ostringstream oss;
+    for(unsigned int i = 0; i < hasher.getHashLength(); ++i)
+        oss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(hash[i]);
+    return oss.str();
+}
+
+std::string ParametersCache::getDirectory()
+{
+    const char* configHome = std::getenv("XDG_CONFIG_HOME");
+    if(configHome && *configHome)
+        return std::string(configHome) + "/group-privacy";
+    const char* home = std::getenv("HOME");
+    return std::string(home ? home : ".") + "/.config/group-privacy";
+}
+
+void ParametersCache::load(const bool validate)
+{
+    if(validated)
+        return;
+    std::string cachedFingerprint, cachedParameters;
+    const bool cached = readFile(cachedFingerprint, cachedParameters);
+    if(offline && !validate)
+    {
+        if(!cached)
+            throw std::runtime_error("No cached parameters in \'" + filename + "\'!");
+        set(cachedFingerprint, cachedParameters);
+        return;
+    }
+    Utils::Writer noArguments;
+    const std::string serializedFingerprint = call(Envelope::GET_PARAMETERS_FINGERPRINT, noArguments);
+    Utils::Reader reader(serializedFingerprint);
+    std::string serverFingerprint;
+    reader >> serverFingerprint;
+    if(cached && cachedFingerprint == serverFingerprint)
+        set(cachedFingerprint, cachedParameters);
+    else
+    {
+        const std::string parameters = call(Envelope::GET_PARAMETERS, noArguments);
+        const std::string parametersFingerprint = createFingerprint(parameters);
+        if(parametersFingerprint != serverFingerprint)
+            throw std::runtime_error("Fingerprint of received parameters doesn't match the server's one!");
+        set(parametersFingerprint, parameters);
+        writeFile(parametersFingerprint, parameters);
+    }
+    validated = true;
+}
+
+std::string ParametersCache::loadBundle(StepOutGroupSignaturesClientManager& verifier,
+                                        const std::string& bundleFilename,
+                                        const std::string& trustedFingerprint)
+{
+    std::ifstream file(bundleFilename.c_str(), std::ios::binary);
+    if(!file.is_open())
+        throw std::runtime_error("File \'" + bundleFilename + "\' doesn't exist!");
+    std::ostringstream oss;
+    oss << file.rdbuf();
+    const std::string serializedBundle = oss.str();
+    Utils::Reader reader(serializedBundle);
+    ParametersBundle bundle;
+    reader >> bundle;
+    if(bundle.getVersion() != ParametersBundle::VERSION)
+        throw std::runtime_error("Unsupported version of parameters bundle \'" + bundleFilename + "\'!");
+    const std::string bundleFingerprint = createFingerprint(bundle.getParameters());
+    if(bundleFingerprint != trustedFingerprint)
+        throw std::runtime_error("Parameters bundle \'" + bundleFilename + "\' doesn't match the trusted fingerprint!");
+    Utils::Reader parameters(bundle.getParameters());
+    GroupZpValues groupZpValues;
+    RSAKey serverPublicKey;
+    parameters >> groupZpValues >> serverPublicKey;
+    SHA256 hasher;
+    hasher.setText(ParametersBundle::createSignedText(bundle.getVersion(), bundle.getParameters()));
+    if(!DigitalSignatureManager::verify(hasher.getHash(), hasher.getHashLength(), bundle.getSigma(), serverPublicKey))
+        throw std::runtime_error("Invalid signature of parameters bundle \'" + bundleFilename + "\'!");
+    setParameters(verifier, bundle.getParameters());
+    return bundleFingerprint;
+}
+
+bool ParametersCache::readFile(std::string& cachedFingerprint, std::string& cachedParameters) const
+{
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if(!std::getline(file, cachedFingerprint))
+        return false;
+    std::ostringstream oss;
+    oss << file.rdbuf();
+    cachedParameters = oss.str();
+    return (createFingerprint(cachedParameters) == cachedFingerprint);
+}
+
+void ParametersCache::set(const std::string& parametersFingerprint, const std::string& parameters)
+{
+    if(parametersFingerprint == fingerprint)
+        return;
+    setParameters(manager, parameters);
+    fingerprint = parametersFingerprint;
+}
+
+void ParametersCache::setParameters(StepOutGroupSignaturesClientManager& target, const std::string& parameters)
+{
+    Utils::Reader reader(parameters);
+    GroupZpValues groupZpValues;
+    RSAKey serverPublicKey;
+    UserPrivateKey dummyUserPrivateKey;
+    reader >> groupZpValues >> serverPublicKey >> dummyUserPrivateKey;
+    target.setGroupZpValues(groupZpValues);
+    target.setServerPublicKey(serverPublicKey);
+    target.setDummyUserPrivateKey(dummyUserPrivateKey);
+}
+
+void ParametersCache::writeFile(const std::string& parametersFingerprint, const std::string& parameters) const
+{
+    const std::string directory = getDirectory();
+    ::mkdir(directory.substr(0, directory.rfind('/')).c_str(), 0700);
+    ::mkdir(directory.c_str(), 0700);
+    const std::string temporaryFilename = filename + ".tmp";
+    {
+        std::ofstream file(temporaryFilename.c_str(), std::ios::binary | std::ios::trunc);
+        file << parametersFingerprint << '\n' << parameters;
+        if(!file.flush())
+        {
+            std::cerr << "Parameters couldn't be cached in \'" << filename << "\'." << std::endl;
+            return;
+        }
+    }
+    if(std::rename(temporaryFilename.c_str(), filename.c_str()) != 0)
+        std::cerr << "Parameters couldn't be cached in \'" << filename << "\'." << std::endl;
+}
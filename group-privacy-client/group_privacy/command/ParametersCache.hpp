@@ -0,0 +1,162 @@
+/**
+ * @file ParametersCache.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains ParametersCache class which keeps
+ * group parameters received from Group Privacy Server
+ * in a local file.
+ */
+
+#ifndef PARAMETERSCACHE_HPP
+#define	PARAMETERSCACHE_HPP
+
+#include "../step_out_group_signatures/StepOutGroupSignaturesClientManager.hpp"
+#include "Envelope.hpp"
+#include "SerializationUtils.hpp"
+
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <string>
+
+/**
+ * ParametersCache class.
+ *
+ * Group values, the server's public key and the dummy user's
+ * private key are kept in a file together with their fingerprint
+ * (SHA-256 of the serialized parameters). The server generates
+ * new parameters whenever it starts, so before the cached ones
+ * are used, their fingerprint is compared with the server's one,
+ * which costs one small request. In offline mode the cached
+ * parameters are used without asking the server, unless they
+ * are needed to register in the group.
+ *
+ * Parameters don't change while the connection lasts, so they
+ * are validated and deserialized once per session. Parameters
+ * can also be loaded from a bundle signed by the server, which
+ * doesn't need a connection at all, into a separate manager.
+ *
+ * Requests are sent through a function given by the owner, so they
+ * are serialized with the owner's other requests on the same connection.
+ *
+ * The class isn't thread-safe.
+ */
+class ParametersCache : private boost::noncopyable
+{
+public:
+    /**
+     * Function which sends a request to Group Privacy Server and returns the response.
+     */
+    typedef boost::function<std::string (const Envelope::Operation, const Utils::Writer&)> Call;
+
+    /**
+     * Constructor of the ParametersCache class.
+     *
+     * @param manager Manager in which parameters are set.
+     * @param call Function used to send requests to Group Privacy Server.
+     * @param filename Name of the file in which parameters are kept.
+     * @param offline True if cached parameters are to be used without validation.
+     */
+    ParametersCache(StepOutGroupSignaturesClientManager& manager,
+                    const Call& call,
+                    const std::string& filename,
+                    const bool offline = false);
+
+    /**
+     * Sets group values, the server's public key and the dummy user's
+     * private key in the manager. Parameters
+     * are received from the server only if the cached ones are missing
+     * or out of date.
+     *
+     * @param validate True if cached parameters are to be validated
+     *                 even in offline mode.
+     *
+     * @throws std::runtime_error Thrown when there are no cached parameters in offline mode
+     *                            or received parameters don't match the server's fingerprint.
+     */
+    void load(const bool validate = false);
+
+    /**
+     * Sets group values, the server's public key and the dummy user's
+     * private key from a bundle exported by the server in a given
+     * manager, which is separate from the cache's one, so that
+     * a bundle doesn't replace parameters of the member's group. The bundle's
+     * signature is checked with the public key it contains, which only
+     * proves that the bundle is intact. Its authenticity comes from
+     * the trusted fingerprint, obtained from the server out of band
+     * (e.g. printed when the bundle was exported): a bundle whose
+     * parameters have another fingerprint is rejected.
+     *
+     * @param verifier Manager in which the parameters are set.
+     * @param bundleFilename Name of the file containing the bundle.
+     * @param trustedFingerprint Expected fingerprint of the parameters.
+     *
+     * @return Fingerprint of the parameters from the bundle.
+     *
+     * @throws std::runtime_error Thrown when the bundle is missing, of an unsupported
+     *                            version, doesn't match the trusted fingerprint
+     *                            or its signature isn't valid.
+     */
+    static std::string loadBundle(StepOutGroupSignaturesClientManager& verifier,
+                                  const std::string& bundleFilename,
+                                  const std::string& trustedFingerprint);
+
+    /**
+     * Creates a name of the file in which parameters of a given server
+     * are kept. The file is placed in \c group-privacy subdirectory of
+     * \c $XDG_CONFIG_HOME, or of \c $HOME/.config if the former isn't set.
+     *
+     * @param host Host of the server or \c unix: followed by a path of a local socket.
+     * @param port Port of the server.
+     *
+     * @return Name of the file.
+     */
+    static std::string createFilename(const std::string& host, const std::string& port);
+
+    /**
+     * Calculates a fingerprint of serialized parameters.
+     *
+     * @param parameters Serialized parameters.
+     *
+     * @return SHA-256 of the parameters written as 64 hexadecimal digits,
+     *         the same as printed by sha256sum.
+     */
+    static std::string createFingerprint(const std::string& parameters);
+private:
+    static std::string getDirectory();
+    bool readFile(std::string& cachedFingerprint, std::string& cachedParameters) const;
+    void set(const std::string& parametersFingerprint, const std::string& parameters);
+    static void setParameters(StepOutGroupSignaturesClientManager& target, const std::string& parameters);
+    void writeFile(const std::string& parametersFingerprint, const std::string& parameters) const;
+
+    StepOutGroupSignaturesClientManager&  manager;         /**< Manager in which parameters are set. */
+    const Call                            call;            /**< Function used to send requests to Group Privacy Server. */
+    const std::string                     filename;        /**< Name of the file in which parameters are kept. */
+    const bool                            offline;         /**< True if cached parameters are used without validation. */
+    std::string                           fingerprint;     /**< Fingerprint of the parameters set in the manager. */
+    bool                                  validated;       /**< True if the parameters set in the manager are up to date. */
+};
+
+#endif // PARAMETERSCACHE_HPP
@@ -30,16 +30,15 @@
 
 #include "PublishCommand.hpp"
 
-#include "../step_out_group_signatures/PublishProcedureInput.hpp"
+#include "SerializationUtils.hpp"
 
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <string>
 
-PublishCommand::PublishCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket),
-      stepOutGroupSignaturesClientManager(StepOutGroupSignaturesClientManager::instance())
+PublishCommand::PublishCommand(boost::shared_ptr<GroupPrivacyClient> client)
+    : ICommand(client)
 {
 }
 
@@ -58,9 +57,8 @@ void PublishCommand::execute()
     try
     {
         Signature signature = determineSignature();
-        send(std::string("publish"));
-        receive<std::string>(); // OK status
-        send(stepOutGroupSignaturesClientManager.createPublishProcedureInput(signature));
+        if(!client->publish(signature))
+            std::cerr << "Published values have been rejected." << std::endl;
     }
     catch(std::exception& e)
     {
@@ -32,10 +32,8 @@
 #ifndef PUBLISHCOMMAND_HPP
 #define	PUBLISHCOMMAND_HPP
 
-#include "../step_out_group_signatures/StepOutGroupSignaturesClientManager.hpp"
 #include "ICommand.hpp"
 
-#include <boost/asio.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include <stdexcept>
@@ -56,9 +54,9 @@ public:
      *
      * Creates an instance of the class.
      *
-     * @param socket Socket used to comunicate with the Group Privacy Server.
+     * @param client Client which performs procedures of the scheme.
      */
-    PublishCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
+    PublishCommand(boost::shared_ptr<GroupPrivacyClient> client);
 
     /**
      * Supports a user during publishing his/her secrets.
@@ -91,8 +89,6 @@ private:
      * @return Content of the file.
      */
     std::string getFileContent(const std::string& filename);
-
-    StepOutGroupSignaturesClientManager& stepOutGroupSignaturesClientManager; /**< Manager which implements scheme algorithms. */
 };
 
 #endif // PUBLISHCOMMAND_HPP
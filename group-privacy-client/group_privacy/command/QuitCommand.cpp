@@ -30,16 +30,21 @@
 
 #include "QuitCommand.hpp"
 
-#include "SerializationUtils.hpp"
-
-QuitCommand::QuitCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket)
+QuitCommand::QuitCommand(boost::shared_ptr<GroupPrivacyClient> client)
+    : ICommand(client)
 {
 }
 
 void QuitCommand::execute()
 {
     std::cout << "QuitCommand::execute() started" << std::endl;
-    send(std::string("quit"));
+    try
+    {
+        client->quit();
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
     std::cout << "QuitCommand::execute() finished" << std::endl;
 }
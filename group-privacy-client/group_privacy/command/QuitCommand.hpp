@@ -34,7 +34,6 @@
 
 #include "ICommand.hpp"
 
-#include <boost/asio.hpp>
 #include <boost/shared_ptr.hpp>
 
 /**
@@ -51,9 +50,9 @@ public:
      * Constructor of the QuitCommand class.
      *
      * Creates an instance of the class.
-     * @param socket Socket used to comunicate with the Group Privacy Server.
+     * @param client Client which performs procedures of the scheme.
      */
-    QuitCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
+    QuitCommand(boost::shared_ptr<GroupPrivacyClient> client);
 
     /**
      * Supports a user during closing of the connection.
@@ -30,33 +30,24 @@
 
 #include "RegisterCommand.hpp"
 
-#include "../key/RSAKey.hpp"
-#include "../step_out_group_signatures/GroupZpValues.hpp"
-#include "../step_out_group_signatures/OPEProcedureInput.hpp"
-#include "../step_out_group_signatures/OPEProcedureOutput.hpp"
+#include <iostream>
 
-#include <boost/lexical_cast.hpp>
-
-#include <cstddef>
-
-RegisterCommand::RegisterCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket),
-      stepOutGroupSignaturesClientManager(StepOutGroupSignaturesClientManager::instance())
+RegisterCommand::RegisterCommand(boost::shared_ptr<GroupPrivacyClient> client)
+    : ICommand(client)
 {
 }
 
 void RegisterCommand::execute()
 {
     std::cout << "RegisterCommand::execute() started" << std::endl;
-    send(std::string("register"));
-    stepOutGroupSignaturesClientManager.setGroupZpValues(receive<GroupZpValues>());
-    send(std::string("ok"));
-    stepOutGroupSignaturesClientManager.setServerPublicKey(receive<RSAKey>());
-    stepOutGroupSignaturesClientManager.initializeUserKeys();
-    send(stepOutGroupSignaturesClientManager.getXPolynomial());
-    PQPolynomials polynomials = receive<PQPolynomials>();
-    send(stepOutGroupSignaturesClientManager.createKeys(polynomials));
-    stepOutGroupSignaturesClientManager.setUserIndex(boost::lexical_cast<unsigned int>(receive<std::string>()));
+    try
+    {
+        client->registerInGroup();
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
     std::cout << "RegisterCommand::execute() finished" << std::endl;
 
 //    std::cout << "RegisterCommand::execute() started" << std::endl;
@@ -32,10 +32,8 @@
 #ifndef REGISTERCOMMAND_HPP
 #define	REGISTERCOMMAND_HPP
 
-#include "../step_out_group_signatures/StepOutGroupSignaturesClientManager.hpp"
 #include "ICommand.hpp"
 
-#include <boost/asio.hpp>
 #include <boost/shared_ptr.hpp>
 
 /**
@@ -52,16 +50,14 @@ public:
      * Constructor of the RegisterCommand class.
      *
      * Creates an instance of the class.
-     * @param socket Socket used to comunicate with the Group Privacy Server.
+     * @param client Client which performs procedures of the scheme.
      */
-    RegisterCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
+    RegisterCommand(boost::shared_ptr<GroupPrivacyClient> client);
 
     /**
      * Supports a user during registration procedure.
      */
     void execute();
-private:
-    StepOutGroupSignaturesClientManager& stepOutGroupSignaturesClientManager; /**< Manager which implements scheme algorithms. */
 };
 
 #endif // REGISTERCOMMAND_HPP
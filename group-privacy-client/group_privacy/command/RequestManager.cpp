@@ -0,0 +1,79 @@
+/**
+ * @file RequestManager.cpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains definitions of the methods from
+ * \c RequestManager class.
+ */
+
+#include "RequestManager.hpp"
+
+RequestManager::RequestManager(boost::shared_ptr<SocketManager::Socket> socket)
+    : socketManager(socket),
+      connected(socket.get() != 0),
+      nextRequestId(0)
+{
+}
+
+std::string RequestManager::call(const Envelope::Operation operation, const Utils::Writer& arguments)
+{
+    return receiveResponse(sendRequest(operation, arguments));
+}
+
+std::string RequestManager::receiveResponse(const unsigned int requestId)
+{
+    while(!responses.count(requestId))
+    {
+        unsigned int responseId;
+        Response response;
+        Envelope::decodeResponse(socketManager.receive(), responseId, response.first, response.second);
+        responses[responseId] = response;
+    }
+    return takeResponse(requestId);
+}
+
+unsigned int RequestManager::sendRequest(const Envelope::Operation operation, const Utils::Writer& arguments)
+{
+    if(!connected)
+        throw std::runtime_error("Not connected to Group Privacy Server!");
+    const unsigned int requestId = nextRequestId++;
+    const Envelope::RequestHeader header = Envelope::encodeRequestHeader(requestId, operation);
+    boost::array<boost::asio::const_buffer, 2> request = {{
+        boost::asio::buffer(header),
+        boost::asio::buffer(arguments.str())
+    }};
+    socketManager.send(request);
+    return requestId;
+}
+
+std::string RequestManager::takeResponse(const unsigned int requestId)
+{
+    std::map<unsigned int, Response>::iterator response = responses.find(requestId);
+    const Response taken = response->second;
+    responses.erase(response);
+    if(!taken.first)
+        throw std::runtime_error(taken.second);
+    return taken.second;
+}
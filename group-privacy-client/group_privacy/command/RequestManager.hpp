@@ -0,0 +1,116 @@
+/**
+ * @file RequestManager.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains RequestManager class which sends
+ * requests to Group Privacy Server and matches them
+ * with the server's responses.
+ */
+
+#ifndef REQUESTMANAGER_HPP
+#define	REQUESTMANAGER_HPP
+
+#include "Envelope.hpp"
+#include "SerializationUtils.hpp"
+#include "SocketManager.hpp"
+
+#include <boost/asio.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+/**
+ * RequestManager class.
+ *
+ * Every request sent to Group Privacy Server gets an identifier
+ * and is answered with exactly one response carrying the same
+ * identifier. Many requests may be sent before their responses
+ * are received, and the responses may come in a different order.
+ * Responses received before they are asked for are kept until then.
+ *
+ * The class isn't thread-safe.
+ */
+class RequestManager : private boost::noncopyable
+{
+public:
+    /**
+     * Constructor of the RequestManager class.
+     *
+     * @param socket Socket used to comunicate with the Group Privacy Server.
+     *               Null if the client isn't connected to the server.
+     */
+    RequestManager(boost::shared_ptr<SocketManager::Socket> socket);
+
+    /**
+     * Sends a request and waits for its response.
+     *
+     * @param operation Requested operation.
+     * @param arguments Arguments of the operation.
+     *
+     * @return Values returned by the operation.
+     *
+     * @throws std::runtime_error Thrown when the operation has failed
+     *                            or the client isn't connected to the server.
+     */
+    std::string call(const Envelope::Operation operation, const Utils::Writer& arguments);
+
+    /**
+     * Waits for the response to a given request.
+     *
+     * @param requestId Identifier of the request.
+     *
+     * @return Values returned by the requested operation.
+     *
+     * @throws std::runtime_error Thrown when the operation has failed.
+     */
+    std::string receiveResponse(const unsigned int requestId);
+
+    /**
+     * Sends a request without waiting for its response.
+     *
+     * @param operation Requested operation.
+     * @param arguments Arguments of the operation.
+     *
+     * @return Identifier of the request.
+     *
+     * @throws std::runtime_error Thrown when the client isn't connected to the server.
+     */
+    unsigned int sendRequest(const Envelope::Operation operation, const Utils::Writer& arguments);
+private:
+    typedef std::pair<bool, std::string> Response;
+
+    std::string takeResponse(const unsigned int requestId);
+
+    SocketManager                           socketManager;   /**< Manager used to send and receive data. */
+    const bool                              connected;       /**< True if the client is connected to the server. */
+    unsigned int                            nextRequestId;   /**< Identifier of the next request. */
+    std::map<unsigned int, Response>        responses;       /**< Responses received before they were asked for. */
+};
+
+#endif // REQUESTMANAGER_HPP
@@ -30,9 +30,14 @@
 #ifndef SERIALIZATIONUTILS_HPP
 #define	SERIALIZATIONUTILS_HPP
 
+#include "../serialization/BinaryIArchive.hpp"
+#include "../serialization/BinaryOArchive.hpp"
+
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
+#include <boost/noncopyable.hpp>
 
+#include <cstddef>
 #include <sstream>
 #include <string>
 
@@ -71,6 +76,91 @@ std::string serialize(const Serializable& serializable)
     return ss.str();
 }
 
+/**
+ * Reader class.
+ *
+ * Deserializes a sequence of objects from one string,
+ * in the order in which they were written by \c Writer.
+ * Objects are decoded directly from the string, so it
+ * has to outlive the reader.
+ */
+class Reader : private boost::noncopyable
+{
+public:
+    /**
+     * Constructor of the Reader class.
+     *
+     * @param serialized String containing serialized objects.
+     */
+    explicit Reader(const std::string& serialized)
+        : archive(serialized.data(), serialized.size())
+    {
+    }
+
+    /**
+     * Deserializes the next object.
+     *
+     * @param deserializable Object to deserialize to.
+     * @return Reference to the reader.
+     */
+    template<typename Deserializable>
+    Reader& operator>>(Deserializable& deserializable)
+    {
+        archive >> deserializable;
+        return *this;
+    }
+private:
+    BinaryIArchive   archive;   /**< Archive reading from the string. */
+};
+
+/**
+ * Writer class.
+ *
+ * Serializes a sequence of objects into one string
+ * in the compact binary format used by the protocol.
+ */
+class Writer : private boost::noncopyable
+{
+public:
+    /**
+     * Constructor of the Writer class.
+     *
+     * @param elementWidth Number of bytes of group elements, which are
+     *                     then written without their lengths (zero if
+     *                     the group isn't known).
+     */
+    explicit Writer(const std::size_t elementWidth = 0)
+        : archive(buffer, elementWidth)
+    {
+    }
+
+    /**
+     * Serializes a given object.
+     *
+     * @param serializable Object to serialize.
+     * @return Reference to the writer.
+     */
+    template<typename Serializable>
+    Writer& operator<<(const Serializable& serializable)
+    {
+        archive << serializable;
+        return *this;
+    }
+
+    /**
+     * Returns all objects serialized so far.
+     *
+     * @return String containing serialized objects.
+     */
+    const std::string& str() const
+    {
+        return buffer;
+    }
+private:
+    std::string      buffer;    /**< String the objects are serialized to. */
+    BinaryOArchive   archive;   /**< Archive writing to the string. */
+};
+
 } // namespace Utils
 
 #endif // SERIALIZATIONUTILS_HPP
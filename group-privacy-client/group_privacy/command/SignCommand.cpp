@@ -31,17 +31,15 @@
 #include "SignCommand.hpp"
 
 #include "../step_out_group_signatures/Signature.hpp"
-#include "../step_out_group_signatures/SignProcedureInput.hpp"
-#include "../step_out_group_signatures/SignProcedureOutput.hpp"
+#include "SerializationUtils.hpp"
 
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <string>
 
-SignCommand::SignCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket),
-      stepOutGroupSignaturesClientManager(StepOutGroupSignaturesClientManager::instance())
+SignCommand::SignCommand(boost::shared_ptr<GroupPrivacyClient> client)
+    : ICommand(client)
 {
 }
 
@@ -60,13 +58,7 @@ void SignCommand::execute()
     try
     {
         boost::tuple<std::string, std::string> message = determineMessage();
-        send(std::string("sign"));
-        receive<std::string>(); // OK status
-        const SignProcedureInput input =
-            stepOutGroupSignaturesClientManager.createSignProcedureInput(boost::get<1>(message));
-        send(input);
-        SignProcedureOutput output = receive<SignProcedureOutput>();
-        saveSignature(boost::get<0>(message), stepOutGroupSignaturesClientManager.createSignature(input, output));
+        saveSignature(boost::get<0>(message), client->sign(boost::get<1>(message)));
     }
     catch(std::exception& e)
     {
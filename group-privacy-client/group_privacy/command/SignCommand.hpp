@@ -33,10 +33,8 @@
 #define	SIGNCOMMAND_HPP
 
 #include "../step_out_group_signatures/Signature.hpp"
-#include "../step_out_group_signatures/StepOutGroupSignaturesClientManager.hpp"
 #include "ICommand.hpp"
 
-#include <boost/asio.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/tuple/tuple.hpp>
 
@@ -58,9 +56,9 @@ public:
      *
      * Creates an instance of the class.
      *
-     * @param socket Socket used to comunicate with the Group Privacy Server.
+     * @param client Client which performs procedures of the scheme.
      */
-    SignCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
+    SignCommand(boost::shared_ptr<GroupPrivacyClient> client);
 
     /**
      * Supports a user during creation of a signature.
@@ -108,8 +106,6 @@ private:
      * @param signature The step-out group signature.
      */
     void saveSignature(const std::string& filename, const Signature& signature);
-
-    StepOutGroupSignaturesClientManager& stepOutGroupSignaturesClientManager; /**< Manager which implements scheme algorithms. */
 };
 
 #endif // SIGNCOMMAND_HPP
@@ -30,26 +30,52 @@
 
 #include "SocketManager.hpp"
 
-#include <boost/assert.hpp>
+#include <boost/lexical_cast.hpp>
 
-const std::size_t SocketManager::DATA_SIZE = 65536;
+#include <stdexcept>
 
-SocketManager::SocketManager(boost::shared_ptr<boost::asio::ip::tcp::socket> socketInit)
+const std::size_t SocketManager::HEADER_SIZE;
+const boost::uint64_t SocketManager::MAX_FRAME_SIZE = 256 * 1024 * 1024;
+
+SocketManager::SocketManager(boost::shared_ptr<Socket> socketInit)
     : socket(socketInit)
 {
 }
 
 std::string SocketManager::receive()
 {
-    boost::array<char, DATA_SIZE> buffer;
-    boost::system::error_code error;
-    std::size_t length = socket->read_some(boost::asio::buffer(buffer), error);
-    BOOST_ASSERT(length < DATA_SIZE);
-    return std::string(buffer.c_array(), length);
+    const boost::uint64_t length = receiveHeader();
+    if(length > MAX_FRAME_SIZE)
+        throw std::runtime_error("Frame of " + boost::lexical_cast<std::string>(length) + " bytes is too big!");
+    std::string data(static_cast<std::size_t>(length), '\0');
+    if(!data.empty())
+        boost::asio::read(*socket, boost::asio::buffer(&data[0], data.size()));
+    return data;
 }
 
 void SocketManager::send(const std::string& data)
 {
-    BOOST_ASSERT(data.size() < DATA_SIZE);
-    socket->write_some(boost::asio::buffer(data));
+    Header header;
+    encodeHeader(data.size(), header);
+    boost::array<boost::asio::const_buffer, 2> frame = {{
+        boost::asio::buffer(header),
+        boost::asio::buffer(data)
+    }};
+    boost::asio::write(*socket, frame);
+}
+
+void SocketManager::encodeHeader(const boost::uint64_t length, Header& header)
+{
+    for(std::size_t i = 0; i < HEADER_SIZE; ++i)
+        header[i] = static_cast<unsigned char>(length >> (8 * (HEADER_SIZE - 1 - i)));
+}
+
+boost::uint64_t SocketManager::receiveHeader()
+{
+    Header header;
+    boost::asio::read(*socket, boost::asio::buffer(header));
+    boost::uint64_t length = 0;
+    for(std::size_t i = 0; i < HEADER_SIZE; ++i)
+        length = (length << 8) | header[i];
+    return length;
 }
@@ -32,34 +32,52 @@
 #ifndef SOCKETMANAGER_HPP
 #define	SOCKETMANAGER_HPP
 
+#include <boost/array.hpp>
 #include <boost/asio.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include <cstring>
 #include <string>
+#include <vector>
 
 /**
- * CheckCommand class.
+ * SocketManager class.
  *
  * It is responsible for data management that is send to
  * or received from Group Privacy Server.
+ *
+ * Data is sent in frames. Every frame starts with a header
+ * containing the payload's length as a 64-bit big-endian number.
+ * Frames are read and written whole, no matter how the stream
+ * splits them into segments. The socket may be of any stream
+ * protocol, so the same frames are exchanged over TCP and over
+ * local (AF_UNIX) connections.
+ *
+ * Every frame is kept whole in memory. Payloads are not streamed;
+ * messages too big to be sent are signed in digest mode instead,
+ * so only their digests reach the server.
  */
 class SocketManager : private boost::noncopyable
 {
 public:
+    typedef boost::asio::generic::stream_protocol::socket Socket;
+
     /**
-     * Constructor of the CheckCommand class.
+     * Constructor of the SocketManager class.
      *
      * Creates an instance of the class.
      * @param socket Socket used to comunicate with the Group Privacy Server.
      */
-    SocketManager(boost::shared_ptr<boost::asio::ip::tcp::socket> socketInit);
+    SocketManager(boost::shared_ptr<Socket> socketInit);
 
     /**
      * Receives data from Group Privacy Server.
      *
      * @return Data sent from Group Privacy Server.
+     *
+     * @throws std::runtime_error Thrown when the data is bigger than \c MAX_FRAME_SIZE.
      */
     std::string receive();
 
@@ -69,9 +87,36 @@ public:
      * @param data Data to send to Group Privacy Server.
      */
     void send(const std::string& data);
+
+    /**
+     * Sends data gathered from a sequence of buffers
+     * to Group Privacy Server, without copying them
+     * into one buffer.
+     *
+     * @param buffers Buffers containing the data.
+     */
+    template<typename ConstBufferSequence>
+    void send(const ConstBufferSequence& buffers);
 private:
-    static const std::size_t                          DATA_SIZE;   /**< Maximal size of sending and receiving data. */
-    boost::shared_ptr<boost::asio::ip::tcp::socket>   socket;      /**< Socket used to send and receive data. */
+    static const std::size_t       HEADER_SIZE = 8;       /**< Size of a frame's header. */
+    static const boost::uint64_t   MAX_FRAME_SIZE;        /**< Maximal size of a received frame. */
+
+    typedef boost::array<unsigned char, HEADER_SIZE> Header;
+
+    static void encodeHeader(const boost::uint64_t length, Header& header);
+    boost::uint64_t receiveHeader();
+
+    boost::shared_ptr<Socket>                         socket;   /**< Socket used to send and receive data. */
 };
 
+template<typename ConstBufferSequence>
+void SocketManager::send(const ConstBufferSequence& buffers)
+{
+    Header header;
+    encodeHeader(boost::asio::buffer_size(buffers), header);
+    std::vector<boost::asio::const_buffer> frame(1, boost::asio::buffer(header));
+    frame.insert(frame.end(), boost::asio::buffer_sequence_begin(buffers), boost::asio::buffer_sequence_end(buffers));
+    boost::asio::write(*socket, frame);
+}
+
 #endif // SOCKETMANAGER_HPP
@@ -0,0 +1,59 @@
+/**
+ * @file StatisticsCommand.cpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains definitions of the methods from
+ * \c StatisticsCommand class.
+ */
+
+#include "StatisticsCommand.hpp"
+
+#include <cstddef>
+#include <iostream>
+
+StatisticsCommand::StatisticsCommand(boost::shared_ptr<GroupPrivacyClient> client)
+    : ICommand(client)
+{
+}
+
+void StatisticsCommand::execute()
+{
+    std::cout << "StatisticsCommand::execute() started" << std::endl;
+    const VerificationStatistics& verification = client->getVerificationStatistics();
+    for(std::size_t i = 0; i < VerificationStatistics::NUMBER_OF_STAGES; ++i)
+    {
+        const VerificationStatistics::Stage stage = static_cast<VerificationStatistics::Stage>(i);
+        std::cout << "Verification stage " << VerificationStatistics::getName(stage) << ": "
+                  << verification.getChecked(stage) << " checked, "
+                  << verification.getRejected(stage) << " rejected, "
+                  << verification.getMicroseconds(stage) << " us." << std::endl;
+    }
+    const PolynomialInTheExponentCache& cache = client->getEvaluationsCache();
+    std::cout << "Evaluations cache: " << cache.getHits() << " hits, "
+              << cache.getMisses() << " misses, "
+              << cache.getSize() << " values kept, "
+              << cache.getTables() << " tables of powers kept." << std::endl;
+    std::cout << "StatisticsCommand::execute() finished" << std::endl;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file StatisticsCommand.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains StatisticsCommand class which is responsible
+ * for interaction between a user and the system when
+ * he/she wants to see statistics of the client.
+ */
+
+#ifndef STATISTICSCOMMAND_HPP
+#define	STATISTICSCOMMAND_HPP
+
+#include "ICommand.hpp"
+
+#include <boost/shared_ptr.hpp>
+
+/**
+ * StatisticsCommand class.
+ *
+ * Implements ICommand interface. It prints how many signatures
+ * were checked and rejected by every stage of verification and
+ * time spent in it, and how many evaluations of polynomials
+ * in the exponent were found in the cache.
+ */
+class StatisticsCommand : public ICommand
+{
+public:
+    /**
+     * Constructor of the StatisticsCommand class.
+     *
+     * Creates an instance of the class.
+     *
+     * @param client Client which performs procedures of the scheme.
+     */
+    StatisticsCommand(boost::shared_ptr<GroupPrivacyClient> client);
+
+    /**
+     * Prints statistics of the client.
+     */
+    void execute();
+};
+
+#endif // STATISTICSCOMMAND_HPP
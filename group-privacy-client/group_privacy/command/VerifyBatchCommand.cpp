@@ -0,0 +1,121 @@
+/**
+ * @file VerifyBatchCommand.cpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains definitions of the methods from
+ * \c VerifyBatchCommand class.
+ */
+
+#include "VerifyBatchCommand.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+VerifyBatchCommand::VerifyBatchCommand(boost::shared_ptr<GroupPrivacyClient> client,
+                                       const bool digestOnly,
+                                       const bool fast)
+    : ICommand(client),
+      digestOnly(digestOnly),
+      fast(fast)
+{
+}
+
+std::vector<GroupPrivacyClient::SerializedSignedMessage> VerifyBatchCommand::determineSignedMessages(
+    std::vector<std::string>& signatureFilenames)
+{
+    std::string listFilename;
+    std::cin >> listFilename;
+    if(!fileExists(listFilename))
+        throw std::runtime_error("File \'" + listFilename + "\' doesn't exist!");
+    std::ifstream list(listFilename.c_str());
+    std::vector<GroupPrivacyClient::SerializedSignedMessage> signedMessages;
+    std::string messageFilename, signatureFilename;
+    while(list >> messageFilename >> signatureFilename)
+    {
+        if(!fileExists(messageFilename))
+            throw std::runtime_error("File \'" + messageFilename + "\' doesn't exist!");
+        if(!fileExists(signatureFilename))
+            throw std::runtime_error("File \'" + signatureFilename + "\' doesn't exist!");
+        std::string message;
+        if(digestOnly)
+        {
+            std::ifstream file(messageFilename.c_str(), std::ios::binary);
+            message = client->createMessageDigest(file);
+        }
+        else
+            message = getFileContent(messageFilename);
+        signedMessages.push_back(GroupPrivacyClient::SerializedSignedMessage(
+            message, getFileContent(signatureFilename)));
+        signatureFilenames.push_back(signatureFilename);
+    }
+    return signedMessages;
+}
+
+void VerifyBatchCommand::execute()
+{
+    std::cout << "VerifyBatchCommand::execute() started" << std::endl;
+    try
+    {
+        unsigned int soundnessBits = 0;
+        if(fast && !(std::cin >> soundnessBits))
+        {
+            std::cin.clear();
+            throw std::runtime_error("Invalid number of bits!");
+        }
+        std::vector<std::string> signatureFilenames;
+        std::vector<GroupPrivacyClient::SerializedSignedMessage> signedMessages =
+            determineSignedMessages(signatureFilenames);
+        client->loadParameters();
+        const std::vector<bool> results = client->verifyBatch(signedMessages, soundnessBits);
+        std::size_t valid = 0;
+        for(std::size_t i = 0; i < results.size(); ++i)
+        {
+            std::cout << signatureFilenames[i] << ": Signature is " << (results[i] ? "valid." : "not valid.") << std::endl;
+            valid += results[i];
+        }
+        std::cout << valid << " of " << results.size() << " signatures are valid." << std::endl;
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+    std::cout << "VerifyBatchCommand::execute() finished" << std::endl;
+}
+
+bool VerifyBatchCommand::fileExists(const std::string& filename)
+{
+    std::ifstream file(filename.c_str());
+    return file.is_open();
+}
+
+std::string VerifyBatchCommand::getFileContent(const std::string& filename)
+{
+    std::ifstream file(filename.c_str());
+    std::ostringstream oss;
+    oss << file.rdbuf();
+    return oss.str();
+}
@@ -0,0 +1,106 @@
+/**
+ * @file VerifyBatchCommand.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains VerifyBatchCommand class which is responsible
+ * for interaction between a user and the system during
+ * verification of many step-out group signatures at once.
+ */
+
+#ifndef VERIFYBATCHCOMMAND_HPP
+#define	VERIFYBATCHCOMMAND_HPP
+
+#include "ICommand.hpp"
+
+#include <boost/shared_ptr.hpp>
+
+#include <string>
+#include <vector>
+
+/**
+ * VerifyBatchCommand class.
+ *
+ * Implements ICommand interface. It reads a list of files in which
+ * every line contains a name of a message file and a name of its
+ * signature file, verifies all signatures at once and prints
+ * the result of every one of them. In fast mode interpolation checks
+ * of signatures are combined into probabilistic batch checks.
+ */
+class VerifyBatchCommand : public ICommand
+{
+public:
+    /**
+     * Constructor of the VerifyBatchCommand class.
+     *
+     * Creates an instance of the class.
+     * @param client Client which performs procedures of the scheme.
+     * @param digestOnly True if signatures were created for digests
+     *                   of messages in place of the messages.
+     * @param fast True if interpolation checks are to be combined. The number
+     *             of bits of random exponents is read before the list.
+     */
+    VerifyBatchCommand(boost::shared_ptr<GroupPrivacyClient> client,
+                       const bool digestOnly = false,
+                       const bool fast = false);
+
+    /**
+     * Supports a user during verification of many step-out group signatures.
+     */
+    void execute();
+private:
+    /**
+     * Gets from standard input a name of a file which lists messages
+     * and their signatures and reads all of them.
+     *
+     * @param signatureFilenames Names of the signatures' files, in the order of the list.
+     *
+     * @return Messages (or their digests in digest only mode) and their serialized signatures.
+     *
+     * @throws std::runtime_error Thrown when one of the files doesn't exist.
+     */
+    std::vector<GroupPrivacyClient::SerializedSignedMessage> determineSignedMessages(
+        std::vector<std::string>& signatureFilenames);
+
+    /**
+     * Checks whether a file of a given name exists.
+     *
+     * @param filename Name of a file.
+     * @return True if the file exists. False otherwise.
+     */
+    bool fileExists(const std::string& filename);
+
+    /**
+     * Extracts content of a given file.
+     *
+     * @param filename Name of a file.
+     * @return Content of the file.
+     */
+    std::string getFileContent(const std::string& filename);
+
+    const bool digestOnly; /**< True if digests of messages were signed in place of the messages. */
+    const bool fast; /**< True if interpolation checks are combined into batch checks. */
+};
+
+#endif // VERIFYBATCHCOMMAND_HPP
@@ -30,18 +30,18 @@
 
 #include "VerifyCommand.hpp"
 
-#include "../key/RSAKey.hpp"
-#include "../step_out_group_signatures/GroupZpValues.hpp"
 #include "../step_out_group_signatures/Signature.hpp"
-#include "../step_out_group_signatures/UserPrivateKey.hpp"
 
 #include <fstream>
 #include <iostream>
 #include <string>
 
-VerifyCommand::VerifyCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket),
-      stepOutGroupSignaturesClientManager(StepOutGroupSignaturesClientManager::instance())
+VerifyCommand::VerifyCommand(boost::shared_ptr<GroupPrivacyClient> client,
+                             const bool digestOnly,
+                             const bool bundled)
+    : ICommand(client),
+      digestOnly(digestOnly),
+      bundled(bundled)
 {
 }
 
@@ -51,6 +51,11 @@ std::string VerifyCommand::determineMessage() throw(std::runtime_error)
     std::cin >> filename;
     if(!fileExists(filename))
         throw std::runtime_error("File \'" + filename + "\' doesn't exist!");
+    if(digestOnly)
+    {
+        std::ifstream file(filename.c_str(), std::ios::binary);
+        return client->createMessageDigest(file);
+    }
     return getFileContent(filename);
 }
 
@@ -60,7 +65,14 @@ Signature VerifyCommand::determineSignature() throw(std::runtime_error)
     std::cin >> filename;
     if(!fileExists(filename))
         throw std::runtime_error("File \'" + filename + "\' doesn't exist!");
-    return Utils::deserialize<Signature>(getFileContent(filename));
+    try
+    {
+        return client->parseSignature(getFileContent(filename));
+    }
+    catch(std::exception&)
+    {
+        throw std::runtime_error("File \'" + filename + "\' doesn't contain a signature!");
+    }
 }
 
 void VerifyCommand::execute()
@@ -68,15 +80,20 @@ void VerifyCommand::execute()
     std::cout << "VerifyCommand::execute() started" << std::endl;
     try
     {
+        std::string bundleFilename, trustedFingerprint;
+        if(bundled)
+            std::cin >> bundleFilename >> trustedFingerprint;
         std::string message = determineMessage();
         Signature signature = determineSignature();
-        send(std::string("verify"));
-        stepOutGroupSignaturesClientManager.setGroupZpValues(receive<GroupZpValues>());
-        send(std::string("ok"));
-        stepOutGroupSignaturesClientManager.setServerPublicKey(receive<RSAKey>());
-        send(std::string("ok"));
-        stepOutGroupSignaturesClientManager.setDummyUserPrivateKey(receive<UserPrivateKey>());
-        if(stepOutGroupSignaturesClientManager.verifySignature(message, signature))
+        bool valid;
+        if(bundled)
+            valid = client->verifyOffline(bundleFilename, trustedFingerprint, message, signature);
+        else
+        {
+            client->loadParameters();
+            valid = client->verify(message, signature);
+        }
+        if(valid)
             std::cout << "Signature is valid." << std::endl;
         else
             std::cout << "Signature is not valid." << std::endl;
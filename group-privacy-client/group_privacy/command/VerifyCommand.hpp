@@ -32,10 +32,8 @@
 #ifndef VERIFYCOMMAND_HPP
 #define	VERIFYCOMMAND_HPP
 
-#include "../step_out_group_signatures/StepOutGroupSignaturesClientManager.hpp"
 #include "ICommand.hpp"
 
-#include <boost/asio.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include <string>
@@ -45,7 +43,9 @@
  *
  * Implements ICommand interface. It is responsible
  * for interaction between a user and the system during
- * verification of step-out group signatures.
+ * verification of step-out group signatures. Group parameters
+ * are received from the server or, in bundled mode, loaded from
+ * a file, which needs no connection to the server.
  */
 class VerifyCommand : public ICommand
 {
@@ -54,9 +54,16 @@ public:
      * Constructor of the VerifyCommand class.
      *
      * Creates an instance of the class.
-     * @param socket Socket used to comunicate with the Group Privacy Server.
+     * @param client Client which performs procedures of the scheme.
+     * @param digestOnly True if a signature was created for a digest
+     *                   of a message in place of the message.
+     * @param bundled True if group parameters are to be loaded from a bundle
+     *                exported by the server. Its name and the parameters' trusted
+     *                fingerprint are read before the message's name.
      */
-    VerifyCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
+    VerifyCommand(boost::shared_ptr<GroupPrivacyClient> client,
+                  const bool digestOnly = false,
+                  const bool bundled = false);
 
     /**
      * Supports a user during verification of a step-out group signature.
@@ -65,7 +72,8 @@ public:
 private:
     /**
      * Gets from standart input a name of a file which contains
-     * message to verify and return its content.
+     * message to verify and return its content (or the content's
+     * digest in digest only mode).
      *
      * @return Message to verify.
      *
@@ -80,7 +88,8 @@ private:
      *
      * @return Step-out group signature.
      *
-     * @throws std::runtime_error Thrown when the provided file doesn't exist.
+     * @throws std::runtime_error Thrown when the provided file doesn't exist
+     *                            or doesn't contain a signature.
      */
     Signature determineSignature() throw(std::runtime_error);
     /**
@@ -99,7 +108,8 @@ private:
      */
     std::string getFileContent(const std::string& filename);
 
-    StepOutGroupSignaturesClientManager& stepOutGroupSignaturesClientManager; /**< Manager which implements scheme algorithms. */
+    const bool digestOnly; /**< True if a digest of a message was signed in place of the message. */
+    const bool bundled; /**< True if group parameters are loaded from a bundle exported by the server. */
 };
 
 #endif // VERIFYCOMMAND_HPP
@@ -0,0 +1,344 @@
+/**
+ * @file GroupPrivacyClient.cpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains definitions of the methods from
+ * \c GroupPrivacyClient class.
+ */
+
+#include "GroupPrivacyClient.hpp"
+
+#include "../command/SerializationUtils.hpp"
+#include "../step_out_group_signatures/CheckProcedureInput.hpp"
+#include "../step_out_group_signatures/FinalizeSignatureInput.hpp"
+#include "../step_out_group_signatures/ParametersBundle.hpp"
+#include "../step_out_group_signatures/PQPolynomials.hpp"
+#include "../step_out_group_signatures/PublishedValues.hpp"
+#include "../step_out_group_signatures/SignProcedureInput.hpp"
+#include "../step_out_group_signatures/SignProcedureOutput.hpp"
+#include "../step_out_group_signatures/UserPublicKey.hpp"
+
+#include <boost/bind.hpp>
+#include <boost/thread/locks.hpp>
+
+#include <stdexcept>
+
+const std::string GroupPrivacyClient::LOCAL_PREFIX = "unix:";
+const std::string GroupPrivacyClient::OFFLINE_HOST = "offline";
+
+GroupPrivacyClient::GroupPrivacyClient(const std::string& host, const std::string& port, const bool offline)
+    : service(),
+      socket(host != OFFLINE_HOST ? connectToServer(host, port) : boost::shared_ptr<SocketManager::Socket>()),
+      manager(),
+      requestManager(new RequestManager(socket)),
+      parametersCache(manager,
+                      boost::bind(&GroupPrivacyClient::call, this, _1, _2),
+                      ParametersCache::createFilename(host, port),
+                      offline),
+      parametersLoaded(false),
+      registered(false)
+{
+}
+
+GroupPrivacyClient::~GroupPrivacyClient()
+{
+    if(socket)
+    {
+        boost::system::error_code error;
+        socket->close(error);
+    }
+}
+
+std::string GroupPrivacyClient::call(const Envelope::Operation operation, const Utils::Writer& arguments)
+{
+    boost::mutex::scoped_lock lock(requestMutex);
+    return requestManager->call(operation, arguments);
+}
+
+boost::optional<CheckContext::Result> GroupPrivacyClient::check(const unsigned int userIndex, const Signature& signature)
+{
+    ReadLock lock(stateMutex);
+    requireParameters();
+    Utils::Writer arguments(manager.getElementWidth());
+    arguments << manager.createCheckProcedureInput(userIndex, signature);
+    const std::string serializedValues = call(Envelope::CHECK, arguments);
+    Utils::Reader values(serializedValues);
+    bool published;
+    values >> published;
+    if(!published)
+        return boost::none;
+    UserPublicKey userPublicKey;
+    PublishedValues publishedValues;
+    values >> userPublicKey >> publishedValues;
+    return manager.check(userPublicKey, publishedValues, signature);
+}
+
+std::vector<GroupPrivacyClient::CheckedUser> GroupPrivacyClient::checkAll(const Signature& signature)
+{
+    ReadLock lock(stateMutex);
+    requireParameters();
+    Utils::Writer arguments(manager.getElementWidth());
+    arguments << signature.getT();
+    const std::string serializedValues = call(Envelope::CHECK_ALL, arguments);
+    Utils::Reader values(serializedValues);
+    unsigned int numberOfUsers;
+    values >> numberOfUsers;
+    std::vector<unsigned int> userIndexes(numberOfUsers);
+    std::vector<StepOutGroupSignaturesClientManager::PublishedUser> publishedUsers(numberOfUsers);
+    for(unsigned int i = 0; i < numberOfUsers; ++i)
+        values >> userIndexes[i] >> publishedUsers[i].first >> publishedUsers[i].second;
+    const std::vector<CheckContext::Result> results = manager.checkAll(publishedUsers, signature);
+    std::vector<CheckedUser> checkedUsers;
+    for(unsigned int i = 0; i < numberOfUsers; ++i)
+        checkedUsers.push_back(CheckedUser(userIndexes[i], results[i]));
+    return checkedUsers;
+}
+
+void GroupPrivacyClient::closeSignature(const unsigned int signatureIndex)
+{
+    ReadLock lock(stateMutex);
+    requireRegistration();
+    Utils::Writer arguments;
+    arguments << manager.createCloseSignatureInput(signatureIndex);
+    call(Envelope::CLOSE_SIGNATURE, arguments);
+}
+
+boost::shared_ptr<SocketManager::Socket> GroupPrivacyClient::connectToServer(const std::string& host,
+                                                                            const std::string& port)
+{
+    using boost::asio::ip::tcp;
+    typedef SocketManager::Socket::endpoint_type Endpoint;
+    boost::shared_ptr<SocketManager::Socket> connectedSocket(new SocketManager::Socket(service));
+    if(host.compare(0, LOCAL_PREFIX.size(), LOCAL_PREFIX) == 0)
+    {
+        boost::asio::local::stream_protocol::endpoint endpoint(host.substr(LOCAL_PREFIX.size()));
+        connectedSocket->connect(Endpoint(endpoint));
+        return connectedSocket;
+    }
+    tcp::resolver resolver(service);
+    tcp::resolver::query query(host, port);
+    tcp::resolver::iterator endpointIterator = resolver.resolve(query);
+    tcp::resolver::iterator end;
+    boost::system::error_code error = boost::asio::error::host_not_found;
+    while(error && endpointIterator != end)
+    {
+        connectedSocket->close();
+        connectedSocket->connect(Endpoint(endpointIterator++->endpoint()), error);
+    }
+    if(error)
+        throw boost::system::system_error(error);
+    return connectedSocket;
+}
+
+std::string GroupPrivacyClient::createMessageDigest(std::istream& message) const
+{
+    return manager.createMessageDigest(message);
+}
+
+std::string GroupPrivacyClient::exportParameters()
+{
+    Utils::Writer noArguments;
+    const std::string serializedBundle = call(Envelope::GET_PARAMETERS_BUNDLE, noArguments);
+    Utils::Reader reader(serializedBundle);
+    ParametersBundle bundle;
+    reader >> bundle;
+    return serializedBundle;
+}
+
+void GroupPrivacyClient::finalizeSignature(const unsigned int signatureIndex)
+{
+    ReadLock lock(stateMutex);
+    requireRegistration();
+    Utils::Writer index;
+    index << signatureIndex;
+    const std::string serializedValues = call(Envelope::GET_FINALIZE_SIGNATURE_INPUT, index);
+    Utils::Reader values(serializedValues);
+    FinalizeSignatureInput input;
+    values >> input;
+    Utils::Writer arguments(manager.getElementWidth());
+    arguments << signatureIndex << manager.createFinalizeProcedureOutput(input);
+    call(Envelope::FINALIZE_SIGNATURE, arguments);
+}
+
+const PolynomialInTheExponentCache& GroupPrivacyClient::getEvaluationsCache() const
+{
+    return manager.getEvaluationsCache();
+}
+
+Signature GroupPrivacyClient::getSignature(const unsigned int signatureIndex)
+{
+    Utils::Writer arguments;
+    arguments << signatureIndex;
+    const std::string serializedSignature = call(Envelope::GET_SIGNATURE, arguments);
+    Utils::Reader values(serializedSignature);
+    Signature signature;
+    values >> signature;
+    return signature;
+}
+
+std::string GroupPrivacyClient::getUserIndex() const
+{
+    ReadLock lock(stateMutex);
+    return manager.getUserIndex();
+}
+
+const VerificationStatistics& GroupPrivacyClient::getVerificationStatistics() const
+{
+    return manager.getVerificationStatistics();
+}
+
+unsigned int GroupPrivacyClient::initializeSignature(const std::string& message, const bool digestOnly)
+{
+    ReadLock lock(stateMutex);
+    requireRegistration();
+    Utils::Writer arguments(manager.getElementWidth());
+    arguments << manager.createInitializeSignatureInput(message);
+    const std::string serializedValues =
+        call(digestOnly ? Envelope::INITIALIZE_SIGNATURE_DIGEST : Envelope::INITIALIZE_SIGNATURE, arguments);
+    Utils::Reader values(serializedValues);
+    unsigned int signatureIndex;
+    values >> signatureIndex;
+    return signatureIndex;
+}
+
+void GroupPrivacyClient::joinSignature(const unsigned int signatureIndex)
+{
+    ReadLock lock(stateMutex);
+    requireRegistration();
+    Utils::Writer index;
+    index << signatureIndex;
+    const std::string serializedValues = call(Envelope::GET_T, index);
+    Utils::Reader values(serializedValues);
+    BigInteger t;
+    values >> t;
+    Utils::Writer arguments(manager.getElementWidth());
+    arguments << signatureIndex << manager.createJoinSignatureInput(t);
+    call(Envelope::JOIN_SIGNATURE, arguments);
+}
+
+void GroupPrivacyClient::loadParameters(const bool validate)
+{
+    WriteLock lock(stateMutex);
+    parametersCache.load(validate);
+    parametersLoaded = true;
+}
+
+Signature GroupPrivacyClient::parseSignature(const std::string& serializedSignature) const
+{
+    return manager.parseSignature(serializedSignature);
+}
+
+bool GroupPrivacyClient::publish(const Signature& signature)
+{
+    ReadLock lock(stateMutex);
+    requireRegistration();
+    Utils::Writer arguments(manager.getElementWidth());
+    arguments << manager.createPublishProcedureInput(signature);
+    const std::string serializedValues = call(Envelope::PUBLISH, arguments);
+    Utils::Reader values(serializedValues);
+    bool accepted;
+    values >> accepted;
+    return accepted;
+}
+
+void GroupPrivacyClient::quit()
+{
+    Utils::Writer noArguments;
+    call(Envelope::QUIT, noArguments);
+}
+
+unsigned int GroupPrivacyClient::registerInGroup()
+{
+    WriteLock lock(stateMutex);
+    parametersCache.load(true);
+    parametersLoaded = true;
+    manager.initializeUserKeys();
+    Utils::Writer x(manager.getElementWidth());
+    x << manager.getXPolynomial();
+    const std::string serializedPolynomials = call(Envelope::CALCULATE_PQ, x);
+    Utils::Reader pq(serializedPolynomials);
+    PQPolynomials polynomials;
+    pq >> polynomials;
+    Utils::Writer userPublicKey(manager.getElementWidth());
+    userPublicKey << manager.createKeys(polynomials);
+    const std::string serializedUserIndex = call(Envelope::REGISTER, userPublicKey);
+    Utils::Reader index(serializedUserIndex);
+    unsigned int userIndex;
+    index >> userIndex;
+    manager.setUserIndex(userIndex);
+    registered = true;
+    return userIndex;
+}
+
+void GroupPrivacyClient::requireParameters() const
+{
+    if(!parametersLoaded)
+        throw std::runtime_error("Group parameters haven't been loaded!");
+}
+
+void GroupPrivacyClient::requireRegistration() const
+{
+    if(!registered)
+        throw std::runtime_error("User hasn't registered in the group!");
+}
+
+Signature GroupPrivacyClient::sign(const std::string& message)
+{
+    ReadLock lock(stateMutex);
+    requireRegistration();
+    const SignProcedureInput input = manager.createSignProcedureInput(message);
+    Utils::Writer arguments(manager.getElementWidth());
+    arguments << input;
+    const std::string serializedValues = call(Envelope::SIGN, arguments);
+    Utils::Reader values(serializedValues);
+    SignProcedureOutput output;
+    values >> output;
+    return manager.createSignature(input, output);
+}
+
+bool GroupPrivacyClient::verify(const std::string& message, const Signature& signature) const
+{
+    ReadLock lock(stateMutex);
+    requireParameters();
+    return manager.verifySignature(message, signature);
+}
+
+bool GroupPrivacyClient::verifyOffline(const std::string& bundleFilename,
+                                       const std::string& trustedFingerprint,
+                                       const std::string& message,
+                                       const Signature& signature) const
+{
+    StepOutGroupSignaturesClientManager verifier;
+    ParametersCache::loadBundle(verifier, bundleFilename, trustedFingerprint);
+    return verifier.verifySignature(message, signature);
+}
+
+std::vector<bool> GroupPrivacyClient::verifyBatch(const std::vector<SerializedSignedMessage>& signedMessages,
+                                                  const unsigned int soundnessBits) const
+{
+    ReadLock lock(stateMutex);
+    requireParameters();
+    return manager.verifyBatch(signedMessages, 0, soundnessBits);
+}
@@ -0,0 +1,321 @@
+/**
+ * @file GroupPrivacyClient.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains GroupPrivacyClient class which gives
+ * access to all procedures of step-out group signatures
+ * without any interaction with a user.
+ */
+
+#ifndef GROUPPRIVACYCLIENT_HPP
+#define	GROUPPRIVACYCLIENT_HPP
+
+#include "../command/ParametersCache.hpp"
+#include "../command/RequestManager.hpp"
+#include "../command/SocketManager.hpp"
+#include "../polynomial_in_the_exponent/PolynomialInTheExponentCache.hpp"
+#include "../step_out_group_signatures/CheckContext.hpp"
+#include "../step_out_group_signatures/Signature.hpp"
+#include "../step_out_group_signatures/StepOutGroupSignaturesClientManager.hpp"
+#include "../step_out_group_signatures/VerificationStatistics.hpp"
+
+#include <boost/asio.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/shared_mutex.hpp>
+
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * GroupPrivacyClient class.
+ *
+ * It is a context of one group member: the connection with
+ * Group Privacy Server, cached group parameters and the member's
+ * keys. All procedures of the scheme are available as methods
+ * which take and return values, and report failures by throwing
+ * exceptions, so the client can be used by other programs
+ * as well as by the interactive session.
+ *
+ * The class is thread-safe. Requests to the server share one
+ * connection, so every request, including those sent by the cache
+ * of parameters, goes through call() and holds one mutex for its
+ * whole round trip: requests are sent one at a time. Verifying and
+ * checking signatures don't need the server once group parameters
+ * are loaded, and many threads may do them at the same time.
+ * Only loading parameters and registering in the group wait
+ * until they are finished.
+ */
+class GroupPrivacyClient : private boost::noncopyable
+{
+public:
+    typedef StepOutGroupSignaturesClientManager::SerializedSignedMessage SerializedSignedMessage;
+
+    /**
+     * Result of checking a user who has published necessary data:
+     * the user's index number and whether he is an author of a signature.
+     */
+    typedef std::pair<unsigned int, CheckContext::Result> CheckedUser;
+
+    /**
+     * Constructor of the GroupPrivacyClient class.
+     *
+     * @param host A host to connect to, \c unix: followed by a path of a local socket
+     *             or \c offline if no connection is to be made.
+     * @param port A server's port to connect. Ignored for local sockets.
+     * @param offline True if cached group parameters are to be used without validation.
+     *
+     * @throws boost::system::system_error Thrown when the server can't be reached.
+     */
+    GroupPrivacyClient(const std::string& host, const std::string& port, const bool offline = false);
+
+    /**
+     * Destructor of the GroupPrivacyClient class.
+     *
+     * Closes the connection with the server.
+     */
+    ~GroupPrivacyClient();
+
+    /**
+     * Checks whether a group member is an author of a signature.
+     *
+     * @param userIndex Index number of the member.
+     * @param signature Step-out group signature.
+     *
+     * @return Result of the check if the member has published necessary data.
+     *         Nothing otherwise, as it is unknown whether he is an author.
+     */
+    boost::optional<CheckContext::Result> check(const unsigned int userIndex, const Signature& signature);
+
+    /**
+     * Checks all group members who have published necessary data
+     * for a signature.
+     *
+     * @param signature Step-out group signature.
+     *
+     * @return Results of the members who have published the data.
+     */
+    std::vector<CheckedUser> checkAll(const Signature& signature);
+
+    /**
+     * Closes a signature, so no more members can join it.
+     *
+     * @param signatureIndex Index number of the signature.
+     */
+    void closeSignature(const unsigned int signatureIndex);
+
+    /**
+     * Creates a digest of a message, which is signed
+     * in place of the message in digest only mode.
+     *
+     * @param message Stream containing the message.
+     *
+     * @return Hexadecimal SHA-256 of the message.
+     */
+    std::string createMessageDigest(std::istream& message) const;
+
+    /**
+     * Receives group parameters signed by the server, which can be
+     * used to verify signatures without a connection.
+     *
+     * @return Serialized bundle of the parameters.
+     */
+    std::string exportParameters();
+
+    /**
+     * Sends the member's share of a signature whose all signers have joined.
+     *
+     * @param signatureIndex Index number of the signature.
+     */
+    void finalizeSignature(const unsigned int signatureIndex);
+
+    /**
+     * Returns the cache of evaluations of polynomials in the exponent.
+     *
+     * @return Cache of evaluations.
+     */
+    const PolynomialInTheExponentCache& getEvaluationsCache() const;
+
+    /**
+     * Receives a signature created by many members.
+     *
+     * @param signatureIndex Index number of the signature.
+     *
+     * @return Step-out group signature.
+     */
+    Signature getSignature(const unsigned int signatureIndex);
+
+    /**
+     * Returns the member's index number.
+     *
+     * @return Index number or \c ? if the member hasn't registered yet.
+     */
+    std::string getUserIndex() const;
+
+    /**
+     * Returns statistics of verification stages.
+     *
+     * @return Statistics of verification.
+     */
+    const VerificationStatistics& getVerificationStatistics() const;
+
+    /**
+     * Starts a signature created by many members.
+     *
+     * @param message Message to sign, or its digest in digest only mode.
+     * @param digestOnly True if a digest is signed in place of the message.
+     *
+     * @return Unique signature's number.
+     */
+    unsigned int initializeSignature(const std::string& message, const bool digestOnly = false);
+
+    /**
+     * Joins the member to signers of a signature.
+     *
+     * @param signatureIndex Index number of the signature.
+     */
+    void joinSignature(const unsigned int signatureIndex);
+
+    /**
+     * Loads group parameters cached or received from the server.
+     * They have to be loaded before signatures are verified or checked.
+     *
+     * @param validate True if cached parameters are to be validated
+     *                 even in offline mode.
+     */
+    void loadParameters(const bool validate = false);
+
+    /**
+     * Deserializes a signature.
+     *
+     * @param serializedSignature Serialized signature.
+     *
+     * @return Step-out group signature.
+     */
+    Signature parseSignature(const std::string& serializedSignature) const;
+
+    /**
+     * Publishes the member's data needed to check whether
+     * he is an author of a signature.
+     *
+     * @param signature Step-out group signature.
+     *
+     * @return False if the data has been rejected. True otherwise.
+     */
+    bool publish(const Signature& signature);
+
+    /**
+     * Ends the session with the server.
+     */
+    void quit();
+
+    /**
+     * Registers the member in the group. New keys are created
+     * and parameters are validated with the server.
+     *
+     * @return Index number assigned to the member.
+     */
+    unsigned int registerInGroup();
+
+    /**
+     * Signs a message on behalf of the group.
+     *
+     * @param message Message to sign.
+     *
+     * @return Step-out group signature.
+     */
+    Signature sign(const std::string& message);
+
+    /**
+     * Verifies a signature.
+     *
+     * @param message Signed message, or its digest in digest only mode.
+     * @param signature Step-out group signature.
+     *
+     * @return True if the signature is valid. False otherwise.
+     */
+    bool verify(const std::string& message, const Signature& signature) const;
+
+    /**
+     * Verifies a signature with group parameters from a bundle exported
+     * by the server. The bundle is loaded into a verifier of its own,
+     * so parameters of the member's group aren't replaced.
+     *
+     * @param bundleFilename Name of the file containing the bundle.
+     * @param trustedFingerprint Expected fingerprint of the bundle's parameters.
+     * @param message Signed message, or its digest in digest only mode.
+     * @param signature Step-out group signature.
+     *
+     * @return True if the signature is valid. False otherwise.
+     *
+     * @throws std::runtime_error Thrown when the bundle can't be loaded
+     *                            or doesn't match the trusted fingerprint.
+     */
+    bool verifyOffline(const std::string& bundleFilename,
+                       const std::string& trustedFingerprint,
+                       const std::string& message,
+                       const Signature& signature) const;
+
+    /**
+     * Verifies many signatures at once.
+     *
+     * @param signedMessages Messages and their serialized signatures.
+     * @param soundnessBits Number of bits of random exponents used to combine
+     *                      interpolation checks, at least 2, or 0 to check them one by one.
+     *
+     * @return Results of verification in the same order as the signatures.
+     *
+     * @throws std::runtime_error Thrown when the soundness parameter is 1.
+     */
+    std::vector<bool> verifyBatch(const std::vector<SerializedSignedMessage>& signedMessages,
+                                  const unsigned int soundnessBits = 0) const;
+private:
+    typedef boost::shared_lock<boost::shared_mutex> ReadLock;
+    typedef boost::unique_lock<boost::shared_mutex> WriteLock;
+
+    std::string call(const Envelope::Operation operation, const Utils::Writer& arguments);
+    boost::shared_ptr<SocketManager::Socket> connectToServer(const std::string& host, const std::string& port);
+    void requireParameters() const;
+    void requireRegistration() const;
+
+    static const std::string LOCAL_PREFIX;   /**< Prefix of hosts which are paths of local sockets. */
+    static const std::string OFFLINE_HOST;   /**< Host which means that no connection is made. */
+
+    boost::asio::io_service                     service;           /**< Service of the socket. It has to outlive the socket. */
+    boost::shared_ptr<SocketManager::Socket>    socket;            /**< Socket used to comunicate with the Group Privacy Server. */
+    StepOutGroupSignaturesClientManager         manager;           /**< Manager which implements scheme algorithms. */
+    boost::shared_ptr<RequestManager>           requestManager;    /**< Manager used to send requests to Group Privacy Server. */
+    ParametersCache                             parametersCache;   /**< Cache of group parameters. */
+    bool                                        parametersLoaded;  /**< True if group parameters have been set in the manager. */
+    bool                                        registered;        /**< True if the member has registered in the group. */
+    boost::mutex                                requestMutex;      /**< Guards the connection for a whole round trip. Locked after \c stateMutex. */
+    mutable boost::shared_mutex                 stateMutex;        /**< Guards the manager's parameters and keys and the cache of parameters. */
+};
+
+#endif // GROUPPRIVACYCLIENT_HPP
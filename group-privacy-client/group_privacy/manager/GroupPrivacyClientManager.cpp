@@ -28,33 +28,15 @@
 #include "GroupPrivacyClientManager.hpp"
 #include "Session.hpp"
 
-GroupPrivacyClientManager::GroupPrivacyClientManager(const std::string& host, const std::string& port)
-    : socket()
+GroupPrivacyClientManager::GroupPrivacyClientManager(const std::string& host,
+                                                     const std::string& port,
+                                                     const bool offline)
+    : client(new GroupPrivacyClient(host, port, offline))
 {
-    connectToServer(host, port);
-}
-
-void GroupPrivacyClientManager::connectToServer(const std::string& host, const std::string& port)
-{
-    using boost::asio::ip::tcp;
-    boost::asio::io_service service;
-    tcp::resolver resolver(service);
-    tcp::resolver::query query(host, port);
-    tcp::resolver::iterator endpointIterator = resolver.resolve(query);
-    tcp::resolver::iterator end;
-    socket.reset(new tcp::socket(service));
-    boost::system::error_code error = boost::asio::error::host_not_found;
-    while(error && endpointIterator != end)
-    {
-        socket->close();
-        socket->connect(*endpointIterator++, error);
-    }
-    if(error)
-        throw boost::system::system_error(error);
 }
 
 void GroupPrivacyClientManager::manage()
 {
-    Session session(socket);
+    Session session(client);
     session.run();
 }
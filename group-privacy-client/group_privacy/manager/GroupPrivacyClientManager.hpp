@@ -32,7 +32,8 @@
 #ifndef GROUPPRIVACYCLIENTMANAGER_HPP
 #define	GROUPPRIVACYCLIENTMANAGER_HPP
 
-#include <boost/asio.hpp>
+#include "GroupPrivacyClient.hpp"
+
 #include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
 
@@ -42,7 +43,11 @@
  * GroupPrivacyClientManager class.
  *
  * It is responsilbe for creating a connection
- * with the Group Privacy Server.
+ * with the Group Privacy Server. The server is reached over TCP,
+ * or over a local (AF_UNIX) stream socket when the host is given
+ * as \c unix:/path/to/socket. When the host is \c offline, no
+ * connection is made and only commands which don't need the server,
+ * such as verification with exported parameters, can be used.
  */
 class GroupPrivacyClientManager : private boost::noncopyable
 {
@@ -50,26 +55,19 @@ public:
     /**
      * Constructor of the GroupPrivacyClientManager class.
      *
-     * @param host A host to connect to.
-     * @param port A server's port to connect.
+     * @param host A host to connect to, \c unix: followed by a path of a local socket
+     *             or \c offline if no connection is to be made.
+     * @param port A server's port to connect. Ignored for local sockets.
+     * @param offline True if cached group parameters are to be used without validation.
      */
-    GroupPrivacyClientManager(const std::string& host, const std::string& port);
+    GroupPrivacyClientManager(const std::string& host, const std::string& port, const bool offline = false);
 
     /**
-     * Initializes and sets up the connection
-     * with the Group Privacy Server.
+     * Runs an interactive session with a user.
      */
     void manage();
 private:
-    /**
-     * Connects to the Group Privacy Server.
-     *
-     * @param host A host to connect to.
-     * @param port A server's port to connect.
-     */
-    void connectToServer(const std::string& host, const std::string& port);
-
-    boost::shared_ptr<boost::asio::ip::tcp::socket> socket; /**< Socket used to comunicate with the Group Privacy Server. */
+    boost::shared_ptr<GroupPrivacyClient> client; /**< Client connected to the Group Privacy Server. */
 };
 
 #endif // GROUPPRIVACYCLIENTMANAGER_HPP
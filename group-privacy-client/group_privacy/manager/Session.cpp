@@ -33,53 +33,61 @@
 
 #include <iostream>
 
-Session::Session(boost::shared_ptr<boost::asio::ip::tcp::socket> socketInit)
-    : socket(socketInit)
+Session::Session(boost::shared_ptr<GroupPrivacyClient> clientInit)
+    : client(clientInit)
 {
     registerCommands();
 }
 
 Session::Session(const Session& session)
     : commands(session.commands),
-      socket(session.socket)
+      client(session.client)
 {
 }
 
 Session& Session::operator=(const Session& session)
 {
     commands = session.commands;
-    socket = session.socket;
+    client = session.client;
     return *this;
 }
 
 void Session::registerCommands()
 {
-    commands["check"].reset(new CheckCommand(socket));
-    commands["close-signature"].reset(new CloseSignatureCommand(socket));
-    commands["finalize-signature"].reset(new FinalizeSignatureCommand(socket));
-    commands["get-signature"].reset(new GetSignatureCommand(socket));
-    commands["initialize-signature"].reset(new InitializeSignatureCommand(socket));
-    commands["join-signature"].reset(new JoinSignatureCommand(socket));
-    commands["publish"].reset(new PublishCommand(socket));
-    commands["quit"].reset(new QuitCommand(socket));
-    commands["register"].reset(new RegisterCommand(socket));
-    commands["sign"].reset(new SignCommand(socket));
-    commands["verify"].reset(new VerifyCommand(socket));
+    commands["check"].reset(new CheckCommand(client));
+    commands["check-all"].reset(new CheckAllCommand(client));
+    commands["close-signature"].reset(new CloseSignatureCommand(client));
+    commands["export-parameters"].reset(new ExportParametersCommand(client));
+    commands["finalize-signature"].reset(new FinalizeSignatureCommand(client));
+    commands["get-signature"].reset(new GetSignatureCommand(client));
+    commands["initialize-signature"].reset(new InitializeSignatureCommand(client));
+    commands["initialize-signature-digest"].reset(new InitializeSignatureCommand(client, true));
+    commands["join-signature"].reset(new JoinSignatureCommand(client));
+    commands["publish"].reset(new PublishCommand(client));
+    commands["quit"].reset(new QuitCommand(client));
+    commands["register"].reset(new RegisterCommand(client));
+    commands["sign"].reset(new SignCommand(client));
+    commands["statistics"].reset(new StatisticsCommand(client));
+    commands["verify"].reset(new VerifyCommand(client));
+    commands["verify-batch"].reset(new VerifyBatchCommand(client));
+    commands["verify-batch-digest"].reset(new VerifyBatchCommand(client, true));
+    commands["verify-batch-fast"].reset(new VerifyBatchCommand(client, false, true));
+    commands["verify-batch-fast-digest"].reset(new VerifyBatchCommand(client, true, true));
+    commands["verify-digest"].reset(new VerifyCommand(client, true));
+    commands["verify-offline"].reset(new VerifyCommand(client, false, true));
+    commands["verify-offline-digest"].reset(new VerifyCommand(client, true, true));
 }
 
 void Session::run()
 {
-    StepOutGroupSignaturesClientManager& stepOutGroupSignaturesClientManager =
-        StepOutGroupSignaturesClientManager::instance();
     std::string command;
     while(command != "quit")
     {
-        std::cout << "[" << stepOutGroupSignaturesClientManager.getUserIndex() << "] > ";
+        std::cout << "[" << client->getUserIndex() << "] > ";
         std::cin >> command;
         if(commands.count(command))
             commands[command]->execute();
         else
             std::cerr << "Unknown command: " << command << std::endl;
     }
-    socket->close();
 }
@@ -31,14 +31,20 @@
 #define	SESSION_HPP
 
 #include "../command/ICommand.hpp"
+#include "GroupPrivacyClient.hpp"
 
-#include <boost/asio.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <map>
+#include <string>
+
 /**
  * Session class.
  *
- * It manages a client's connection.
+ * It manages a client's connection. Commands read their
+ * arguments from standard input and print their results,
+ * while procedures of the scheme are performed by
+ * \c GroupPrivacyClient.
  */
 class Session
 {
@@ -48,9 +54,9 @@ public:
      *
      * Creates an instance of the class.
      *
-     * @param socket Socket used to comunicate with the Group Privacy Server.
+     * @param client Client which performs procedures of the scheme.
      */
-    Session(boost::shared_ptr<boost::asio::ip::tcp::socket> socketInit);
+    Session(boost::shared_ptr<GroupPrivacyClient> clientInit);
 
     /**
      * Copy constructor of the Session class.
@@ -81,8 +87,8 @@ private:
      */
     void registerCommands();
 
-    std::map<std::string, boost::shared_ptr<ICommand> >   commands;   /**< Container for all possible commands. */
-    boost::shared_ptr<boost::asio::ip::tcp::socket>       socket;     /**< Socket used to comunicate with the Group Privacy Server. */
+    std::map<std::string, boost::shared_ptr<ICommand> >   commands;         /**< Container for all possible commands. */
+    boost::shared_ptr<GroupPrivacyClient>                 client;           /**< Client shared by all commands. */
 };
 
 #endif // SESSION_HPP
@@ -31,7 +31,10 @@
 
 #include <boost/assert.hpp>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <stdexcept>
 
 BigInteger::BigInteger()
 {
@@ -201,6 +204,12 @@ BigInteger& BigInteger::powm(const BigInteger& p_power, const BigInteger& p_mod)
     return *this;
 }
 
+BigInteger& BigInteger::mulm(const BigInteger& p_factor, const BigInteger& p_mod)
+{
+    gcry_mpi_mulm(m_mpi, m_mpi, p_factor.m_mpi, p_mod.m_mpi);
+    return *this;
+}
+
 BigInteger& BigInteger::invm(const BigInteger& p_inv, const BigInteger& p_mod)
 {
     gcry_mpi_invm(m_mpi, p_inv.m_mpi, p_mod.m_mpi);
@@ -211,3 +220,45 @@ bool BigInteger::isPrime() const
 {
     return (gcry_prime_check(m_mpi, 0) == 0);
 }
+
+unsigned int BigInteger::getNumberOfBits() const
+{
+    return gcry_mpi_get_nbits(m_mpi);
+}
+
+bool BigInteger::testBit(const unsigned int p_bit) const
+{
+    return (gcry_mpi_test_bit(m_mpi, p_bit) != 0);
+}
+
+std::size_t BigInteger::getNumberOfBytes() const
+{
+    return (gcry_mpi_get_nbits(m_mpi) + 7) / 8;
+}
+
+bool BigInteger::toBytes(unsigned char* p_buffer, const std::size_t p_length) const
+{
+    if(gcry_mpi_cmp_ui(m_mpi, 0u) < 0)
+        return false;
+    std::size_t l_length = getNumberOfBytes();
+    if(l_length > p_length)
+        return false;
+    std::memset(p_buffer, 0, p_length - l_length);
+    if(l_length == 0)
+        return true;
+    gcry_error_t l_error = gcry_mpi_print(GCRYMPI_FMT_USG, p_buffer + (p_length - l_length), l_length, NULL, m_mpi);
+    return !l_error;
+}
+
+void BigInteger::fromBytes(const unsigned char* p_buffer, const std::size_t p_length)
+{
+    gcry_mpi_t l_mpi = NULL;
+    gcry_error_t l_error = gcry_mpi_scan(&l_mpi, GCRYMPI_FMT_USG, p_buffer, p_length, NULL);
+    if(l_error)
+    {
+        gcry_mpi_release(l_mpi);
+        throw std::runtime_error(std::string("Invalid big-endian integer: ") + gcry_strerror(l_error));
+    }
+    std::swap(m_mpi, l_mpi);
+    gcry_mpi_release(l_mpi);
+}
@@ -39,6 +39,7 @@
 
 #include <gcrypt.h>
 
+#include <cstddef>
 #include <iosfwd>
 #include <string>
 
@@ -359,6 +360,17 @@ public:
      */
     BigInteger& powm(const BigInteger& p_power, const BigInteger& p_mod);
 
+    /**
+     * Calculates and assigns the product of the BigInteger object
+     * and another one without creating temporary objects.
+     * *this = (*this) * p_factor mod p_mod
+     *
+     * @param p_factor Factor of the calculation.
+     * @param p_mod Modulo value.
+     * @return Reference to the BigInteger object after calculation.
+     */
+    BigInteger& mulm(const BigInteger& p_factor, const BigInteger& p_mod);
+
     /**
      * Sets the BigInteger object to the multiplicative inverse
      * of \c p_inv modulo \c p_mod.
@@ -376,6 +388,52 @@ public:
      */
     bool isPrime() const;
 
+    /**
+     * Returns the number of bits of the absolute value
+     * of the multi precision number.
+     *
+     * @return Number of bits.
+     */
+    unsigned int getNumberOfBits() const;
+
+    /**
+     * Checks whether a given bit of the absolute value
+     * of the multi precision number is set.
+     *
+     * @param p_bit Number of the bit, starting from the least significant one.
+     * @return True if the bit is set. False otherwise.
+     */
+    bool testBit(const unsigned int p_bit) const;
+
+    /**
+     * Returns the number of bytes needed to write
+     * the absolute value of the multi precision number.
+     *
+     * @return Number of bytes.
+     */
+    std::size_t getNumberOfBytes() const;
+
+    /**
+     * Writes the multi precision number as a big-endian unsigned
+     * integer of a fixed length, padded with leading zeros.
+     *
+     * @param p_buffer Buffer to write to.
+     * @param p_length Number of bytes to write.
+     * @return False if the number is negative or doesn't fit into \c p_length bytes.
+     */
+    bool toBytes(unsigned char* p_buffer, const std::size_t p_length) const;
+
+    /**
+     * Sets the BigInteger object to a big-endian unsigned integer.
+     *
+     * @param p_buffer Buffer to read from.
+     * @param p_length Number of bytes to read.
+     *
+     * @throws std::runtime_error Thrown when the bytes can't be read.
+     *                            The object is left unchanged then.
+     */
+    void fromBytes(const unsigned char* p_buffer, const std::size_t p_length);
+
     /**
      * Returns \c std::string object containing hex representation
      * of the multi precision number stored in BigInteger object.
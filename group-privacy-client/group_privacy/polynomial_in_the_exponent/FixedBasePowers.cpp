@@ -0,0 +1,71 @@
+/**
+ * @file FixedBasePowers.cpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains definitions of the methods from
+ * \c FixedBasePowers class.
+ */
+
+#include "FixedBasePowers.hpp"
+
+#include <boost/assert.hpp>
+
+const unsigned int FixedBasePowers::DEFAULT_WINDOW_BITS;
+
+FixedBasePowers::FixedBasePowers()
+    : windowBits(DEFAULT_WINDOW_BITS)
+{
+}
+
+FixedBasePowers::FixedBasePowers(const BigInteger& base,
+                                 const BigInteger& modulo,
+                                 const unsigned int windowBits)
+    : windowBits(windowBits),
+      powers(std::size_t(1) << windowBits)
+{
+    BOOST_ASSERT(windowBits > 0 && windowBits < 16);
+    powers[0] = 1u;
+    powers[1] = base % modulo;
+    for(std::size_t digit = 2; digit < powers.size(); ++digit)
+    {
+        powers[digit] = powers[digit-1];
+        powers[digit].mulm(powers[1], modulo);
+    }
+}
+
+const BigInteger& FixedBasePowers::operator[](const std::size_t digit) const
+{
+    return powers[digit];
+}
+
+unsigned int FixedBasePowers::getWindowBits() const
+{
+    return windowBits;
+}
+
+bool FixedBasePowers::empty() const
+{
+    return powers.empty();
+}
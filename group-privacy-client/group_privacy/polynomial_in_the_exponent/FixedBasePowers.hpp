@@ -0,0 +1,112 @@
+/**
+ * @file FixedBasePowers.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains FixedBasePowers class which keeps
+ * precomputed powers of a fixed base.
+ */
+
+#ifndef FIXEDBASEPOWERS_HPP
+#define	FIXEDBASEPOWERS_HPP
+
+#include "../mpi/BigInteger.hpp"
+
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * FixedBasePowers class.
+ *
+ * Keeps base^0, base^1, ..., base^(2^windowBits - 1), i.e. powers
+ * of a base by all digits of exponents written in windows of
+ * \c windowBits bits. Products of many bases raised to exponents
+ * are then calculated window by window with squarings shared by all
+ * bases and one multiplication per base and window, without creating
+ * the tables again (see \c PolynomialInTheExponentUtils::multiplyPowers).
+ */
+class FixedBasePowers
+{
+    friend class boost::serialization::access;
+public:
+    /**
+     * Constructor of the FixedBasePowers class.
+     *
+     * Creates an empty table, e.g. to be deserialized.
+     */
+    FixedBasePowers();
+
+    /**
+     * Constructor of the FixedBasePowers class.
+     *
+     * Precomputes powers of a base.
+     *
+     * @param base Fixed base.
+     * @param modulo Modulus.
+     * @param windowBits Number of exponents' bits processed at once.
+     */
+    FixedBasePowers(const BigInteger& base,
+                    const BigInteger& modulo,
+                    const unsigned int windowBits = DEFAULT_WINDOW_BITS);
+
+    /**
+     * Returns the base raised to a digit.
+     *
+     * @param digit Digit lower than 2^windowBits.
+     *
+     * @return base^digit.
+     */
+    const BigInteger& operator[](const std::size_t digit) const;
+
+    /**
+     * Returns number of exponents' bits processed at once.
+     *
+     * @return Number of bits of a window.
+     */
+    unsigned int getWindowBits() const;
+
+    /**
+     * Checks whether the table contains precomputed powers.
+     *
+     * @return True if the table has been created empty. False otherwise.
+     */
+    bool empty() const;
+
+    static const unsigned int   DEFAULT_WINDOW_BITS = 5;   /**< Default number of exponents' bits processed at once. */
+private:
+    template<typename Archive>
+    void serialize(Archive& archive, const unsigned int version)
+    {
+        archive & windowBits;
+        archive & powers;
+    }
+
+    unsigned int              windowBits;   /**< Number of exponents' bits processed at once. */
+    std::vector<BigInteger>   powers;       /**< base^digit at digit. */
+};
+
+#endif // FIXEDBASEPOWERS_HPP
@@ -0,0 +1,172 @@
+/**
+ * @file PolynomialInTheExponentCache.cpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains definitions of the methods from
+ * \c PolynomialInTheExponentCache class.
+ */
+
+#include "PolynomialInTheExponentCache.hpp"
+
+#include "../hash/SHA256.hpp"
+
+#include <vector>
+
+const std::size_t PolynomialInTheExponentCache::DEFAULT_CAPACITY;
+const std::size_t PolynomialInTheExponentCache::TABLES_CAPACITY;
+const std::size_t PolynomialInTheExponentCache::PRECOMPUTATION_THRESHOLD;
+
+PolynomialInTheExponentCache::PolynomialInTheExponentCache(const std::size_t capacity)
+    : capacity(capacity),
+      hits(0),
+      misses(0)
+{
+}
+
+void PolynomialInTheExponentCache::clear()
+{
+    boost::mutex::scoped_lock lock(mutex);
+    index.clear();
+    entries.clear();
+    tablesIndex.clear();
+    tables.clear();
+}
+
+std::size_t PolynomialInTheExponentCache::getHits() const
+{
+    return hits;
+}
+
+std::size_t PolynomialInTheExponentCache::getMisses() const
+{
+    return misses;
+}
+
+std::size_t PolynomialInTheExponentCache::getSize() const
+{
+    boost::mutex::scoped_lock lock(mutex);
+    return index.size();
+}
+
+std::size_t PolynomialInTheExponentCache::getTables() const
+{
+    boost::mutex::scoped_lock lock(mutex);
+    std::size_t precomputed = 0;
+    for(Tables::const_iterator it = tables.begin(); it != tables.end(); ++it)
+    {
+        if(it->second.table)
+            ++precomputed;
+    }
+    return precomputed;
+}
+
+bool PolynomialInTheExponentCache::createKey(const BigInteger* first,
+                                             const BigInteger* last,
+                                             const BigInteger* param,
+                                             const BigInteger& modulo,
+                                             std::string& key)
+{
+    const std::size_t length = modulo.getNumberOfBytes();
+    std::vector<unsigned char> buffer((last - first + (param ? 2 : 1)) * length);
+    unsigned char* position = &buffer[0];
+    for(; first != last; ++first, position += length)
+    {
+        if(!first->toBytes(position, length))
+            return false;
+    }
+    if(param)
+    {
+        if(!param->toBytes(position, length))
+            return false;
+        position += length;
+    }
+    if(!modulo.toBytes(position, length))
+        return false;
+    SHA256 hasher;
+    hasher.setText(&buffer[0], buffer.size());
+    key = hasher.getHexHash();
+    return true;
+}
+
+bool PolynomialInTheExponentCache::find(const std::string& key, BigInteger& value)
+{
+    boost::mutex::scoped_lock lock(mutex);
+    Index::iterator it = index.find(key);
+    if(it == index.end())
+        return false;
+    entries.splice(entries.begin(), entries, it->second);
+    value = it->second->second;
+    return true;
+}
+
+void PolynomialInTheExponentCache::insert(const std::string& key, const BigInteger& value)
+{
+    if(capacity == 0)
+        return;
+    boost::mutex::scoped_lock lock(mutex);
+    if(index.find(key) != index.end())
+        return;
+    if(index.size() == capacity)
+    {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+    entries.push_front(Entry(key, value));
+    index[key] = entries.begin();
+}
+
+bool PolynomialInTheExponentCache::findTable(const std::string& key, boost::shared_ptr<const void>& table)
+{
+    boost::mutex::scoped_lock lock(mutex);
+    TablesIndex::iterator it = tablesIndex.find(key);
+    if(it == tablesIndex.end())
+    {
+        if(tables.size() == TABLES_CAPACITY)
+        {
+            tablesIndex.erase(tables.back().first);
+            tables.pop_back();
+        }
+        tables.push_front(Table(key, Usage()));
+        it = tablesIndex.insert(std::make_pair(key, tables.begin())).first;
+    }
+    tables.splice(tables.begin(), tables, it->second);
+    Usage& usage = it->second->second;
+    ++usage.evaluations;
+    table = usage.table;
+    return (table || usage.evaluations >= PRECOMPUTATION_THRESHOLD);
+}
+
+void PolynomialInTheExponentCache::insertTable(const std::string& key, boost::shared_ptr<const void>& table)
+{
+    boost::mutex::scoped_lock lock(mutex);
+    TablesIndex::iterator it = tablesIndex.find(key);
+    if(it == tablesIndex.end())
+        return;
+    Usage& usage = it->second->second;
+    if(usage.table)
+        table = usage.table;
+    else
+        usage.table = table;
+}
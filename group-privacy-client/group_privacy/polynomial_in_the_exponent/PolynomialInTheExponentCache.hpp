@@ -0,0 +1,255 @@
+/**
+ * @file PolynomialInTheExponentCache.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains PolynomialInTheExponentCache class which
+ * keeps values of polynomials in the exponent evaluated
+ * in particular points.
+ */
+
+#ifndef POLYNOMIALINTHEEXPONENTCACHE_HPP
+#define	POLYNOMIALINTHEEXPONENTCACHE_HPP
+
+#include "../mpi/BigInteger.hpp"
+#include "PolynomialInTheExponent.hpp"
+#include "PrecomputedPolynomialInTheExponent.hpp"
+
+#include <boost/atomic.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <utility>
+
+/**
+ * PolynomialInTheExponentCache class.
+ *
+ * Evaluating a polynomial in the exponent costs one modular
+ * exponentiation per coefficient, while the value depends only
+ * on the coefficients, the point and the modulus. The cache keeps
+ * values of recently evaluated polynomials, so checking or verifying
+ * the same signature again doesn't evaluate them once more.
+ *
+ * Values are identified by SHA-256 of the coefficients, the point
+ * and the modulus, so a polynomial which has changed never matches
+ * its old values. When the cache is full, the least recently used
+ * value is dropped.
+ *
+ * Long-lived polynomials, such as users' Qm(t), are also evaluated
+ * in many points. Once such a polynomial has been evaluated in
+ * \c PRECOMPUTATION_THRESHOLD points, powers of its coefficients are
+ * precomputed (see \c PrecomputedPolynomialInTheExponent) and kept
+ * for its next evaluations. Creating the tables costs about two
+ * plain evaluations and every evaluation with them about a half
+ * of one, so they aren't created for polynomials evaluated once.
+ * A table of a Qm(t) takes about 0.7 MiB, so only
+ * the most recently used tables are kept.
+ *
+ * The class is thread-safe. Polynomials are evaluated outside
+ * of the lock, so threads don't wait for each other's evaluations.
+ */
+class PolynomialInTheExponentCache : private boost::noncopyable
+{
+public:
+    /**
+     * Constructor of the PolynomialInTheExponentCache class.
+     *
+     * @param capacity Maximal number of kept values.
+     */
+    explicit PolynomialInTheExponentCache(const std::size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * Evaluates a polynomial in the exponent in a given point,
+     * unless its value is already kept.
+     *
+     * @param polynomial Polynomial in the exponent, plain or with precomputed powers.
+     * @param param Point in which the polynomial is evaluated.
+     * @param modulo Modulus of the coefficients.
+     *
+     * @return Value of the polynomial in the point.
+     */
+    template<typename PolynomialType>
+    BigInteger evaluate(const PolynomialType& polynomial,
+                        const BigInteger& param,
+                        const BigInteger& modulo);
+
+    /**
+     * Evaluates a long-lived polynomial in the exponent in a given point,
+     * unless its value is already kept. Powers of the coefficients are
+     * precomputed once the polynomial has been evaluated often enough.
+     *
+     * @param polynomial Polynomial in the exponent.
+     * @param param Point in which the polynomial is evaluated.
+     * @param modulo Modulus of the coefficients.
+     *
+     * @return Value of the polynomial in the point.
+     */
+    template<std::size_t D>
+    BigInteger evaluateLongLived(const PolynomialInTheExponent<D>& polynomial,
+                                 const BigInteger& param,
+                                 const BigInteger& modulo);
+
+    /**
+     * Drops all kept values. Counters of hits and misses are kept.
+     */
+    void clear();
+
+    /**
+     * Returns number of evaluations whose values were already kept.
+     *
+     * @return Number of hits.
+     */
+    std::size_t getHits() const;
+
+    /**
+     * Returns number of evaluations whose values had to be calculated.
+     *
+     * @return Number of misses.
+     */
+    std::size_t getMisses() const;
+
+    /**
+     * Returns number of kept values.
+     *
+     * @return Number of kept values.
+     */
+    std::size_t getSize() const;
+
+    /**
+     * Returns number of kept tables of precomputed powers.
+     *
+     * @return Number of kept tables.
+     */
+    std::size_t getTables() const;
+
+    static const std::size_t                  DEFAULT_CAPACITY = 4096;           /**< Default maximal number of kept values. */
+    static const std::size_t                  TABLES_CAPACITY = 32;              /**< Maximal number of long-lived polynomials followed. */
+    static const std::size_t                  PRECOMPUTATION_THRESHOLD = 4;      /**< Number of evaluations after which powers are precomputed. */
+private:
+    /**
+     * Followed long-lived polynomial: number of its evaluations
+     * and, once precomputed, its tables of powers.
+     */
+    struct Usage
+    {
+        Usage() : evaluations(0) {}
+
+        std::size_t                           evaluations;   /**< Number of evaluations which weren't kept. */
+        boost::shared_ptr<const void>         table;         /**< Precomputed polynomial. Empty until it's worth creating. */
+    };
+
+    typedef std::pair<std::string, BigInteger>                      Entry;
+    typedef std::list<Entry>                                        Entries;
+    typedef boost::unordered_map<std::string, Entries::iterator>    Index;
+    typedef std::pair<std::string, Usage>                           Table;
+    typedef std::list<Table>                                        Tables;
+    typedef boost::unordered_map<std::string, Tables::iterator>     TablesIndex;
+
+    static bool createKey(const BigInteger* first,
+                          const BigInteger* last,
+                          const BigInteger* param,
+                          const BigInteger& modulo,
+                          std::string& key);
+    bool find(const std::string& key, BigInteger& value);
+    void insert(const std::string& key, const BigInteger& value);
+    bool findTable(const std::string& key, boost::shared_ptr<const void>& table);
+    void insertTable(const std::string& key, boost::shared_ptr<const void>& table);
+
+    const std::size_t                         capacity;      /**< Maximal number of kept values. */
+    mutable boost::mutex                      mutex;         /**< Guards entries, tables and their indexes. */
+    Entries                                   entries;       /**< Kept values, the most recently used first. */
+    Index                                     index;         /**< Kept values by their keys. */
+    Tables                                    tables;        /**< Followed polynomials, the most recently used first. */
+    TablesIndex                               tablesIndex;   /**< Followed polynomials by keys of their coefficients. */
+    boost::atomic<std::size_t>                hits;       /**< Number of evaluations whose values were kept. */
+    boost::atomic<std::size_t>                misses;     /**< Number of evaluations whose values were calculated. */
+};
+
+template<typename PolynomialType>
+BigInteger PolynomialInTheExponentCache::evaluate(const PolynomialType& polynomial,
+                                                  const BigInteger& param,
+                                                  const BigInteger& modulo)
+{
+    std::string key;
+    if(!createKey(polynomial.getCoefficients().begin(), polynomial.getCoefficients().end(), &param, modulo, key))
+    {
+        ++misses;
+        return polynomial(param, modulo);
+    }
+    BigInteger value;
+    if(find(key, value))
+    {
+        ++hits;
+        return value;
+    }
+    ++misses;
+    value = polynomial(param, modulo);
+    insert(key, value);
+    return value;
+}
+
+template<std::size_t D>
+BigInteger PolynomialInTheExponentCache::evaluateLongLived(const PolynomialInTheExponent<D>& polynomial,
+                                                           const BigInteger& param,
+                                                           const BigInteger& modulo)
+{
+    typedef PrecomputedPolynomialInTheExponent<D> Precomputed;
+    const BigInteger* first = polynomial.getCoefficients().begin();
+    const BigInteger* last = polynomial.getCoefficients().end();
+    std::string key, tableKey;
+    if(!createKey(first, last, &param, modulo, key) || !createKey(first, last, 0, modulo, tableKey))
+    {
+        ++misses;
+        return polynomial(param, modulo);
+    }
+    BigInteger value;
+    if(find(key, value))
+    {
+        ++hits;
+        return value;
+    }
+    ++misses;
+    boost::shared_ptr<const void> table;
+    if(!findTable(tableKey, table))
+        value = polynomial(param, modulo);
+    else
+    {
+        if(!table)
+        {
+            table = boost::make_shared<const Precomputed>(polynomial, modulo);
+            insertTable(tableKey, table);
+        }
+        value = (*boost::static_pointer_cast<const Precomputed>(table))(param, modulo);
+    }
+    insert(key, value);
+    return value;
+}
+
+#endif // POLYNOMIALINTHEEXPONENTCACHE_HPP
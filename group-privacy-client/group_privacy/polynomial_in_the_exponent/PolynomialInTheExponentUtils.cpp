@@ -27,9 +27,124 @@
 
 #include "PolynomialInTheExponentUtils.hpp"
 
+#include <algorithm>
+
 namespace PolynomialInTheExponentUtils
 {
 
+namespace
+{
+
+const unsigned int   WINDOW_NBITS = 4;     /**< Number of exponents' bits processed at once. */
+const std::size_t    MAX_BASES    = 256;   /**< Maximal number of bases whose powers are precomputed at once. */
+
+unsigned int getWindow(const BigInteger& exponent, const unsigned int window, const unsigned int windowBits)
+{
+    unsigned int digit = 0;
+    for(unsigned int bit = windowBits; bit-- > 0; )
+        digit = (digit << 1) | (exponent.testBit(window * windowBits + bit) ? 1 : 0);
+    return digit;
+}
+
+BigInteger multiplyPowersOfChunk(const std::vector<BigInteger>& bases,
+                                 const std::vector<BigInteger>& exponents,
+                                 const std::size_t first,
+                                 const std::size_t last,
+                                 const BigInteger& p)
+{
+    std::vector<FixedBasePowers> powers;
+    powers.reserve(last - first);
+    for(std::size_t i = first; i < last; ++i)
+        powers.push_back(FixedBasePowers(bases[i], p, WINDOW_NBITS));
+    return multiplyPowers(&powers[0], &powers[0] + powers.size(), &exponents[first], p);
+}
+
+} // namespace
+
+std::vector<BigInteger> createLagrangeCoefficients(const std::vector<BigInteger>& args,
+                                                   const BigInteger& x,
+                                                   const BigInteger& q)
+{
+    const std::size_t size = args.size();
+    std::vector<BigInteger> coefficients(size);
+    BigInteger product(1u);
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        coefficients[i] = product;
+        product = (product * ((x - args[i]) % q)) % q;
+    }
+    product = 1u;
+    for(std::size_t i = size; i-- > 0; )
+    {
+        coefficients[i] = (coefficients[i] * product) % q;
+        product = (product * ((x - args[i]) % q)) % q;
+    }
+    std::vector<BigInteger> denominators(size, BigInteger(1u));
+    std::vector<BigInteger> denominatorsProducts(size);
+    product = 1u;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        for(std::size_t j = 0; j < size; ++j)
+        {
+            if(i != j)
+                denominators[i] = (denominators[i] * ((args[i] - args[j]) % q)) % q;
+        }
+        denominatorsProducts[i] = product;
+        product = (product * denominators[i]) % q;
+    }
+    BigInteger inverse = invm(product, q);
+    for(std::size_t i = size; i-- > 0; )
+    {
+        coefficients[i] = (coefficients[i] * ((inverse * denominatorsProducts[i]) % q)) % q;
+        inverse = (inverse * denominators[i]) % q;
+    }
+    return coefficients;
+}
+
+BigInteger multiplyPowers(const std::vector<BigInteger>& bases,
+                          const std::vector<BigInteger>& exponents,
+                          const BigInteger& p)
+{
+    BOOST_ASSERT(bases.size() == exponents.size());
+    BigInteger result(1u);
+    for(std::size_t first = 0; first < bases.size(); first += MAX_BASES)
+    {
+        const std::size_t last = std::min(first + MAX_BASES, bases.size());
+        result.mulm(multiplyPowersOfChunk(bases, exponents, first, last, p), p);
+    }
+    return result;
+}
+
+BigInteger multiplyPowers(const FixedBasePowers* first,
+                          const FixedBasePowers* last,
+                          const BigInteger* exponents,
+                          const BigInteger& p)
+{
+    BigInteger result(1u);
+    if(first == last)
+        return result;
+    const std::size_t size = last - first;
+    const unsigned int windowBits = first->getWindowBits();
+    unsigned int nbits = 0;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        BOOST_ASSERT(first[i].getWindowBits() == windowBits);
+        nbits = std::max(nbits, exponents[i].getNumberOfBits());
+    }
+    for(unsigned int window = (nbits + windowBits - 1) / windowBits; window-- > 0; )
+    {
+        for(unsigned int bit = 0; bit < windowBits; ++bit)
+            result.mulm(result, p);
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            const unsigned int digit = getWindow(exponents[i], window, windowBits);
+            if(digit)
+                result.mulm(first[i][digit], p);
+        }
+    }
+    return result;
+}
+
 BigInteger interpolatePolynomialInPoint(const std::vector<BigInteger>& args,
                                         const std::vector<BigInteger>& values,
                                         const BigInteger& x,
@@ -38,23 +153,7 @@ BigInteger interpolatePolynomialInPoint(const std::vector<BigInteger>& args,
     BOOST_ASSERT(args.size() == values.size());
     BigInteger exponentModulo = (p - 1) / 2;
     BOOST_ASSERT(exponentModulo.isPrime());
-    BigInteger result(1u);
-    for(std::vector<BigInteger>::size_type i = 0; i < args.size(); ++i)
-    {
-        BigInteger exponent(1u);
-        for(std::vector<BigInteger>::size_type j = 0; j < args.size(); ++j)
-        {
-            if(i == j)
-                continue;
-            BigInteger numerator = (x - args[j]) % exponentModulo;
-            BigInteger denominator = (args[i] - args[j]) % exponentModulo;
-            BigInteger odwrotnosc = invm(denominator, exponentModulo);
-            BigInteger factor = (numerator * odwrotnosc) % exponentModulo;
-            exponent = (exponent * factor) % exponentModulo;
-        }
-        result = (result * powm(values[i], exponent, p)) % p;
-    }
-    return result;
+    return multiplyPowers(values, createLagrangeCoefficients(args, x, exponentModulo), p);
 }
 
 } // namespace PolynomialInTheExponentUtils
@@ -29,6 +29,7 @@
 #define	POLYNOMIALINTHEEXPONENTUTILS_HPP
 
 #include "../mpi/BigInteger.hpp"
+#include "FixedBasePowers.hpp"
 
 #include <boost/array.hpp>
 #include <boost/assert.hpp>
@@ -150,6 +151,67 @@ void interpolatePolynomial(boost::array<BigInteger, Size>& coefficients,
     reverseCoefficients(coefficients);
 }
 
+/**
+ * Calculates Lagrange coefficients of given arguments in a given point,
+ * so that f(x) = sum of f(args[i]) * coefficients[i] for every polynomial f
+ * of a degree lower than the number of arguments. All denominators
+ * are inverted at once, so only one modular inversion is needed.
+ *
+ * @param args Distinct arguments.
+ * @param x Point.
+ * @param q Prime modulus.
+ * @return Coefficients modulo \c q in the order of the arguments.
+ */
+std::vector<BigInteger> createLagrangeCoefficients(const std::vector<BigInteger>& args,
+                                                   const BigInteger& x,
+                                                   const BigInteger& q);
+
+/**
+ * Calculates a product of bases raised to given exponents. All powers
+ * are calculated together, so they share one chain of squarings.
+ *
+ * @param bases Bases.
+ * @param exponents Non-negative exponents, one for every base.
+ * @param p Modulus.
+ * @return Product of bases[i] ^ exponents[i] modulo \c p.
+ */
+BigInteger multiplyPowers(const std::vector<BigInteger>& bases,
+                          const std::vector<BigInteger>& exponents,
+                          const BigInteger& p);
+
+/**
+ * Calculates a product of bases raised to given exponents, using
+ * precomputed powers of the bases. All powers share one chain
+ * of squarings, so every window of exponents' bits costs one
+ * multiplication per base.
+ *
+ * @param first Powers of the first base.
+ * @param last Powers of the past-the-last base. All tables must have the same window.
+ * @param exponents Non-negative exponents, one for every base.
+ * @param p Modulus the powers were calculated for.
+ * @return Product of bases[i] ^ exponents[i] modulo \c p.
+ */
+BigInteger multiplyPowers(const FixedBasePowers* first,
+                          const FixedBasePowers* last,
+                          const BigInteger* exponents,
+                          const BigInteger& p);
+
+template<std::size_t Size>
+BigInteger evaluatePolynomialMod(const boost::array<FixedBasePowers, Size>& coefficientsPowers,
+                                 const BigInteger& param,
+                                 const BigInteger& modulo)
+{
+    std::vector<BigInteger> exponents(Size);
+    BigInteger power(1u);
+    BigInteger exponentModulo = modulo - BigInteger(1u);
+    for(std::size_t i = 0; i < Size; ++i)
+    {
+        exponents[i] = power;
+        power.mulm(param, exponentModulo);
+    }
+    return multiplyPowers(coefficientsPowers.begin(), coefficientsPowers.end(), &exponents[0], modulo);
+}
+
 BigInteger interpolatePolynomialInPoint(const std::vector<BigInteger>& args,
                                         const std::vector<BigInteger>& values,
                                         const BigInteger& x,
@@ -0,0 +1,128 @@
+/**
+ * @file PrecomputedPolynomialInTheExponent.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains PrecomputedPolynomialInTheExponent class which
+ * keeps a polynomial in the exponent together with precomputed
+ * powers of its coefficients.
+ */
+
+#ifndef PRECOMPUTEDPOLYNOMIALINTHEEXPONENT_HPP
+#define	PRECOMPUTEDPOLYNOMIALINTHEEXPONENT_HPP
+
+#include "../mpi/BigInteger.hpp"
+#include "FixedBasePowers.hpp"
+#include "PolynomialInTheExponent.hpp"
+#include "PolynomialInTheExponentUtils.hpp"
+
+#include <boost/array.hpp>
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/array.hpp>
+
+#include <cstddef>
+
+/**
+ * PrecomputedPolynomialInTheExponent class.
+ *
+ * Coefficients of long-lived polynomials in the exponent, such as
+ * the dummy user's Q(t), are fixed bases raised to powers of t
+ * over and over. The class keeps a \c FixedBasePowers table of every
+ * coefficient, so all powers are calculated together with one chain
+ * of squarings and one multiplication per coefficient and window of
+ * exponents' bits, instead of a modular exponentiation per coefficient.
+ * Tables of the default window take 2^5 numbers per coefficient,
+ * small enough to stay in the processor's cache.
+ *
+ * Tables are serialized along with the polynomial. Evaluation
+ * modulo a different number than the tables were computed for
+ * falls back to the polynomial itself.
+ */
+template<std::size_t D>
+class PrecomputedPolynomialInTheExponent
+{
+    friend class boost::serialization::access;
+public:
+    PrecomputedPolynomialInTheExponent();
+    PrecomputedPolynomialInTheExponent(const PolynomialInTheExponent<D>& polynomial,
+                                       const BigInteger& modulo,
+                                       const unsigned int windowBits = FixedBasePowers::DEFAULT_WINDOW_BITS);
+    BigInteger operator()(const BigInteger& param, const BigInteger& modulo) const;
+    const boost::array<BigInteger, D+1>& getCoefficients() const;
+    const PolynomialInTheExponent<D>& getPolynomial() const;
+private:
+    template<typename Archive>
+    void serialize(Archive& archive, const unsigned int version)
+    {
+        archive & polynomial;
+        archive & modulo;
+        archive & coefficientsPowers;
+    }
+
+    PolynomialInTheExponent<D>            polynomial;
+    BigInteger                            modulo;
+    boost::array<FixedBasePowers, D+1>    coefficientsPowers;
+};
+
+template<std::size_t D>
+PrecomputedPolynomialInTheExponent<D>::PrecomputedPolynomialInTheExponent()
+    : polynomial(),
+      modulo(0u),
+      coefficientsPowers()
+{
+}
+
+template<std::size_t D>
+PrecomputedPolynomialInTheExponent<D>::PrecomputedPolynomialInTheExponent(
+    const PolynomialInTheExponent<D>& polynomial,
+    const BigInteger& modulo,
+    const unsigned int windowBits)
+    : polynomial(polynomial),
+      modulo(modulo)
+{
+    for(std::size_t i = 0; i < coefficientsPowers.size(); ++i)
+        coefficientsPowers[i] = FixedBasePowers(polynomial[i], modulo, windowBits);
+}
+
+template<std::size_t D>
+BigInteger PrecomputedPolynomialInTheExponent<D>::operator()(const BigInteger& param, const BigInteger& modulo) const
+{
+    if(modulo != this->modulo || coefficientsPowers[0].empty())
+        return polynomial(param, modulo);
+    return PolynomialInTheExponentUtils::evaluatePolynomialMod(coefficientsPowers, param, modulo);
+}
+
+template<std::size_t D>
+const boost::array<BigInteger, D+1>& PrecomputedPolynomialInTheExponent<D>::getCoefficients() const
+{
+    return polynomial.getCoefficients();
+}
+
+template<std::size_t D>
+const PolynomialInTheExponent<D>& PrecomputedPolynomialInTheExponent<D>::getPolynomial() const
+{
+    return polynomial;
+}
+
+#endif // PRECOMPUTEDPOLYNOMIALINTHEEXPONENT_HPP
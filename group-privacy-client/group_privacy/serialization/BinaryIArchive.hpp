@@ -0,0 +1,185 @@
+/**
+ * @file BinaryIArchive.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains BinaryIArchive class which deserializes
+ * objects from the compact binary format used by the protocol.
+ */
+
+#ifndef BINARYIARCHIVE_HPP
+#define	BINARYIARCHIVE_HPP
+
+#include "../mpi/BigInteger.hpp"
+
+#include <boost/array.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/serialization/access.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_enum.hpp>
+
+#include <cstddef>
+#include <new>
+#include <string>
+#include <vector>
+
+/**
+ * BinaryIArchive class.
+ *
+ * Deserializes objects written by \c BinaryOArchive.
+ * Values are decoded directly from a given buffer, which
+ * has to outlive the archive; nothing is copied
+ * except the values themselves. Reading past the end of the data
+ * throws \c std::runtime_error.
+ */
+class BinaryIArchive : private boost::noncopyable
+{
+public:
+    typedef boost::mpl::false_ is_saving;
+    typedef boost::mpl::true_ is_loading;
+
+    /**
+     * Constructor of the BinaryIArchive class.
+     *
+     * Checks the format's version and reads the width of group elements.
+     *
+     * @param p_data Serialized data.
+     * @param p_size Size of the data.
+     *
+     * @throws std::runtime_error Thrown when the format's version isn't supported.
+     */
+    BinaryIArchive(const char* p_data, const std::size_t p_size);
+
+    template<typename T>
+    BinaryIArchive& operator>>(T& p_value);
+
+    template<typename T>
+    BinaryIArchive& operator&(T& p_value);
+private:
+    void load(bool& p_value);
+    void load(std::string& p_value);
+    void load(BigInteger& p_value);
+    template<typename T, std::size_t N>
+    void load(boost::array<T, N>& p_array);
+    template<typename T>
+    void load(boost::shared_ptr<T>& p_pointer);
+    template<typename T>
+    void load(std::vector<T>& p_vector);
+    template<typename T>
+    void load(T& p_value);
+    template<typename T>
+    void load(T& p_value, boost::true_type p_isNumber);
+    template<typename T>
+    void load(T& p_value, boost::false_type p_isNumber);
+    std::size_t loadLength();
+    boost::uint64_t loadNumber(const std::size_t p_size);
+    const unsigned char* take(const std::size_t p_size);
+
+    const unsigned char*   m_position;       /**< Next byte to decode. */
+    const unsigned char*   m_end;            /**< End of the data. */
+    std::size_t            m_elementWidth;   /**< Number of bytes of group elements. */
+};
+
+template<typename T>
+BinaryIArchive& BinaryIArchive::operator>>(T& p_value)
+{
+    load(p_value);
+    return *this;
+}
+
+template<typename T>
+BinaryIArchive& BinaryIArchive::operator&(T& p_value)
+{
+    load(p_value);
+    return *this;
+}
+
+template<typename T, std::size_t N>
+void BinaryIArchive::load(boost::array<T, N>& p_array)
+{
+    for(std::size_t i = 0; i < N; ++i)
+        load(p_array[i]);
+}
+
+template<typename T>
+void BinaryIArchive::load(boost::shared_ptr<T>& p_pointer)
+{
+    bool l_present;
+    load(l_present);
+    if(!l_present)
+    {
+        p_pointer.reset();
+        return;
+    }
+    // Serializable classes may keep their default constructors private
+    // and befriend boost::serialization::access, as Boost archives expect.
+    T* l_object = static_cast<T*>(::operator new(sizeof(T)));
+    try
+    {
+        boost::serialization::access::construct(l_object);
+    }
+    catch(...)
+    {
+        ::operator delete(l_object);
+        throw;
+    }
+    p_pointer.reset(l_object);
+    load(*p_pointer);
+}
+
+template<typename T>
+void BinaryIArchive::load(std::vector<T>& p_vector)
+{
+    const std::size_t l_size = loadLength();
+    p_vector.clear();
+    for(std::size_t i = 0; i < l_size; ++i)
+    {
+        p_vector.push_back(T());
+        load(p_vector.back());
+    }
+}
+
+template<typename T>
+void BinaryIArchive::load(T& p_value)
+{
+    load(p_value, boost::integral_constant<bool, boost::is_arithmetic<T>::value || boost::is_enum<T>::value>());
+}
+
+template<typename T>
+void BinaryIArchive::load(T& p_value, boost::true_type)
+{
+    p_value = static_cast<T>(loadNumber(8));
+}
+
+template<typename T>
+void BinaryIArchive::load(T& p_value, boost::false_type)
+{
+    boost::serialization::access::serialize(*this, p_value, 0);
+}
+
+#endif // BINARYIARCHIVE_HPP
@@ -0,0 +1,187 @@
+/**
+ * @file BinaryOArchive.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains BinaryOArchive class which serializes
+ * objects into the compact binary format used by the protocol.
+ */
+
+#ifndef BINARYOARCHIVE_HPP
+#define	BINARYOARCHIVE_HPP
+
+#include "../mpi/BigInteger.hpp"
+
+#include <boost/array.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/serialization/access.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_enum.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * BinaryOArchive class.
+ *
+ * Serializes objects into a compact, versioned binary format.
+ * Objects are written by their own \c serialize methods, the same
+ * which are used with Boost archives, but the archive writes
+ * no class information, only values:
+ * - the archive starts with one byte containing \c FORMAT_VERSION
+ *   and the width of group elements (4 bytes, big-endian),
+ * - a boolean takes one byte,
+ * - other numbers take 8 bytes, big-endian,
+ * - a string takes its length (4 bytes, big-endian) and its characters,
+ * - a BigInteger which isn't negative, fits into the width of group
+ *   elements and is shorter by less than 4 bytes takes \c FIXED_WIDTH
+ *   (1 byte) and its value, big-endian, padded with leading zeros,
+ * - another BigInteger takes its sign (1 byte, \c NON_NEGATIVE
+ *   or \c NEGATIVE), the length of its absolute value
+ *   (4 bytes, big-endian) and the absolute value, big-endian,
+ * - a vector takes its size (4 bytes, big-endian) and its elements,
+ * - an array takes its elements,
+ * - a shared pointer takes one byte, 1 if it's not null, and the object.
+ *
+ * Bytes are appended directly to a given buffer.
+ *
+ * The width of group elements is given by the code which knows
+ * the group, as the number of bytes of p, so that values modulo p
+ * or q don't need their lengths. With a 65-bit p they take 10 bytes
+ * instead of 13 or 14 and a signature of one signer takes 697 bytes
+ * instead of 786 (most of the rest is the server's RSA signature);
+ * writing and reading take as long as before.
+ */
+class BinaryOArchive : private boost::noncopyable
+{
+public:
+    typedef boost::mpl::true_ is_saving;
+    typedef boost::mpl::false_ is_loading;
+
+    static const unsigned char FORMAT_VERSION = 2;   /**< Version of the binary format. */
+
+    static const unsigned char NON_NEGATIVE = 0;     /**< Tag of a non-negative BigInteger with its length. */
+    static const unsigned char NEGATIVE = 1;         /**< Tag of a negative BigInteger with its length. */
+    static const unsigned char FIXED_WIDTH = 2;      /**< Tag of a BigInteger of the width of group elements. */
+
+    /**
+     * Constructor of the BinaryOArchive class.
+     *
+     * Writes the format's version and the width of group elements.
+     *
+     * @param p_buffer Buffer to which the bytes are appended.
+     * @param p_elementWidth Number of bytes of group elements (zero if
+     *                       all BigIntegers are to be written with their lengths).
+     */
+    explicit BinaryOArchive(std::string& p_buffer, const std::size_t p_elementWidth = 0);
+
+    template<typename T>
+    BinaryOArchive& operator<<(const T& p_value);
+
+    template<typename T>
+    BinaryOArchive& operator&(const T& p_value);
+private:
+    void save(const bool p_value);
+    void save(const std::string& p_value);
+    void save(const BigInteger& p_value);
+    template<typename T, std::size_t N>
+    void save(const boost::array<T, N>& p_array);
+    template<typename T>
+    void save(const boost::shared_ptr<T>& p_pointer);
+    template<typename T>
+    void save(const std::vector<T>& p_vector);
+    template<typename T>
+    void save(const T& p_value);
+    template<typename T>
+    void save(const T& p_value, boost::true_type p_isNumber);
+    template<typename T>
+    void save(const T& p_value, boost::false_type p_isNumber);
+    void saveLength(const std::size_t p_length);
+    void saveNumber(const boost::uint64_t p_value, const std::size_t p_size);
+
+    std::string&        m_buffer;         /**< Buffer to which the bytes are appended. */
+    const std::size_t   m_elementWidth;   /**< Number of bytes of group elements. */
+};
+
+template<typename T>
+BinaryOArchive& BinaryOArchive::operator<<(const T& p_value)
+{
+    save(p_value);
+    return *this;
+}
+
+template<typename T>
+BinaryOArchive& BinaryOArchive::operator&(const T& p_value)
+{
+    save(p_value);
+    return *this;
+}
+
+template<typename T, std::size_t N>
+void BinaryOArchive::save(const boost::array<T, N>& p_array)
+{
+    for(std::size_t i = 0; i < N; ++i)
+        save(p_array[i]);
+}
+
+template<typename T>
+void BinaryOArchive::save(const boost::shared_ptr<T>& p_pointer)
+{
+    save(static_cast<bool>(p_pointer));
+    if(p_pointer)
+        save(*p_pointer);
+}
+
+template<typename T>
+void BinaryOArchive::save(const std::vector<T>& p_vector)
+{
+    saveLength(p_vector.size());
+    for(std::size_t i = 0; i < p_vector.size(); ++i)
+        save(p_vector[i]);
+}
+
+template<typename T>
+void BinaryOArchive::save(const T& p_value)
+{
+    save(p_value, boost::integral_constant<bool, boost::is_arithmetic<T>::value || boost::is_enum<T>::value>());
+}
+
+template<typename T>
+void BinaryOArchive::save(const T& p_value, boost::true_type)
+{
+    saveNumber(static_cast<boost::uint64_t>(p_value), 8);
+}
+
+template<typename T>
+void BinaryOArchive::save(const T& p_value, boost::false_type)
+{
+    boost::serialization::access::serialize(*this, const_cast<T&>(p_value), 0);
+}
+
+#endif // BINARYOARCHIVE_HPP
@@ -0,0 +1,89 @@
+/**
+ * @file CheckContext.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains CheckContext class which keeps values
+ * shared by checks whether a user is an author of a signature.
+ */
+
+#ifndef CHECKCONTEXT_HPP
+#define	CHECKCONTEXT_HPP
+
+#include "../mpi/BigInteger.hpp"
+#include "PublishedValues.hpp"
+#include "Signature.hpp"
+#include "Theta.hpp"
+
+/**
+ * CheckContext class.
+ *
+ * Both checks, whether a user is and whether a user isn't an author
+ * of a signature, need g^(rL(t,x(t))) calculated from the user's
+ * published values and Theta of the signature. The context calculates
+ * them once, so a user is told to be a signer, a non-signer or a cheater
+ * in a single pass.
+ *
+ * The context refers to the signature and the published values,
+ * so they have to outlive it.
+ */
+class CheckContext
+{
+public:
+    /**
+     * Result of a check.
+     */
+    enum Result
+    {
+        SIGNER,       /**< The user is an author of the signature. */
+        NOT_SIGNER,   /**< The user isn't an author of the signature. */
+        CHEATER,      /**< The user's published values are not real. */
+        UNKNOWN       /**< The user couldn't be checked because of a local failure. */
+    };
+
+    /**
+     * Constructor of the CheckContext class.
+     *
+     * @param signature Step-out group signature.
+     * @param publishedValues Data published by the user that is to be checked.
+     * @param grLtxt Value g^(rL(t,x(t))) calculated from the published values.
+     * @param theta Theta of the signature.
+     */
+    CheckContext(const Signature& signature,
+                 const PublishedValues& publishedValues,
+                 const BigInteger& grLtxt,
+                 const Theta& theta);
+
+    const Signature& getSignature() const;
+    const PublishedValues& getPublishedValues() const;
+    const BigInteger& getGrLtxt() const;
+    const Theta& getTheta() const;
+private:
+    const Signature&          signature;         /**< Step-out group signature. */
+    const PublishedValues&    publishedValues;   /**< Data published by the user. */
+    const BigInteger          grLtxt;            /**< g^(rL(t,x(t))) calculated from the published values. */
+    const Theta               theta;             /**< Theta of the signature. */
+};
+
+#endif // CHECKCONTEXT_HPP
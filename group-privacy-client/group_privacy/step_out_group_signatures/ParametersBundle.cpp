@@ -0,0 +1,87 @@
+/**
+ * @file ParametersBundle.cpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ */
+
+#include "ParametersBundle.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+const unsigned int ParametersBundle::VERSION;
+
+ParametersBundle::ParametersBundle() : boost::tuple<unsigned int, std::string, Sigma>()
+{
+}
+
+ParametersBundle::ParametersBundle(const unsigned int version, const std::string& parameters, const Sigma& sigma)
+    : boost::tuple<unsigned int, std::string, Sigma>(version, parameters, sigma)
+{
+}
+
+ParametersBundle::ParametersBundle(const ParametersBundle& bundle)
+    : boost::tuple<unsigned int, std::string, Sigma>(bundle)
+{
+}
+
+ParametersBundle& ParametersBundle::operator=(const ParametersBundle& bundle)
+{
+    boost::tuple<unsigned int, std::string, Sigma>::operator=(bundle);
+    return *this;
+}
+
+const unsigned int& ParametersBundle::getVersion() const
+{
+    return boost::get<0>(*this);
+}
+
+unsigned int& ParametersBundle::getVersion()
+{
+    return boost::get<0>(*this);
+}
+
+const std::string& ParametersBundle::getParameters() const
+{
+    return boost::get<1>(*this);
+}
+
+std::string& ParametersBundle::getParameters()
+{
+    return boost::get<1>(*this);
+}
+
+const Sigma& ParametersBundle::getSigma() const
+{
+    return boost::get<2>(*this);
+}
+
+Sigma& ParametersBundle::getSigma()
+{
+    return boost::get<2>(*this);
+}
+
+std::string ParametersBundle::createSignedText(const unsigned int version, const std::string& parameters)
+{
+    return boost::lexical_cast<std::string>(version) + ":" + parameters;
+}
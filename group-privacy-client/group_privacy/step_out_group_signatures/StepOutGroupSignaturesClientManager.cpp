@@ -32,23 +32,101 @@
 #include "../hash/SHA256.hpp"
 #include "../key/RSAKey.hpp"
 #include "../mpi/BigInteger.hpp"
+#include "../polynomial_in_the_exponent/PolynomialInTheExponentUtils.hpp"
 #include "Utils.hpp"
 
 #include <boost/assign.hpp>
 #include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/ref.hpp>
+#include <boost/thread/thread.hpp>
 
 #include <algorithm>
 #include <cstddef>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
 
-StepOutGroupSignaturesClientManager StepOutGroupSignaturesClientManager::manager;
+const std::size_t StepOutGroupSignaturesClientManager::BATCH_SIZE;
+const unsigned int StepOutGroupSignaturesClientManager::MIN_SOUNDNESS_BITS;
 
 StepOutGroupSignaturesClientManager::StepOutGroupSignaturesClientManager()
     : registered(false)
 {
 }
 
+CheckContext::Result StepOutGroupSignaturesClientManager::check(const UserPublicKey& publicKey,
+                                                                const PublishedValues& publishedValues,
+                                                                const Signature& signature) const
+{
+    CheckContext context = createCheckContext(publicKey, publishedValues, signature);
+    if(isSigner(context))
+        return CheckContext::SIGNER;
+    return (isNotSigner(context) ? CheckContext::NOT_SIGNER : CheckContext::CHEATER);
+}
+
+std::vector<CheckContext::Result> StepOutGroupSignaturesClientManager::checkAll(
+    const std::vector<PublishedUser>& publishedUsers,
+    const Signature& signature,
+    std::size_t threads) const
+{
+    std::vector<CheckContext::Result> results(publishedUsers.size(), CheckContext::UNKNOWN);
+    boost::atomic<std::size_t> nextItem(0);
+    if(threads == 0)
+        threads = std::max(boost::thread::hardware_concurrency(), 1u);
+    threads = std::min(threads, publishedUsers.size());
+    boost::thread_group workers;
+    for(std::size_t i = 1; i < threads; ++i)
+        workers.create_thread(boost::bind(&StepOutGroupSignaturesClientManager::checkAllItems,
+                                          this,
+                                          boost::cref(publishedUsers),
+                                          boost::cref(signature),
+                                          boost::ref(nextItem),
+                                          boost::ref(results)));
+    checkAllItems(publishedUsers, signature, nextItem, results);
+    workers.join_all();
+    return results;
+}
+
+void StepOutGroupSignaturesClientManager::checkAllItems(const std::vector<PublishedUser>& publishedUsers,
+                                                        const Signature& signature,
+                                                        boost::atomic<std::size_t>& nextItem,
+                                                        std::vector<CheckContext::Result>& results) const
+{
+    for(std::size_t i = nextItem++; i < publishedUsers.size(); i = nextItem++)
+    {
+        try
+        {
+            results[i] = check(publishedUsers[i].first, publishedUsers[i].second, signature);
+        }
+        catch(std::exception&)
+        {
+            results[i] = CheckContext::UNKNOWN;
+        }
+    }
+}
+
+void StepOutGroupSignaturesClientManager::checkSoundnessBits(const unsigned int soundnessBits)
+{
+    if(soundnessBits != 0 && soundnessBits < MIN_SOUNDNESS_BITS)
+        throw std::runtime_error("Soundness parameter must be 0 or at least "
+                                 + boost::lexical_cast<std::string>(MIN_SOUNDNESS_BITS) + " bits!");
+}
+
+CheckContext StepOutGroupSignaturesClientManager::createCheckContext(const UserPublicKey& publicKey,
+                                                                     const PublishedValues& publishedValues,
+                                                                     const Signature& signature) const
+{
+    BigInteger gQt = powm(evaluationsCache.evaluateLongLived(publicKey.getQm(), publishedValues.getT(), groupZpValues->p),
+                          invm(publishedValues.getMt(), groupZpValues->q),
+                          groupZpValues->p);
+    BigInteger grLtxt = (powm(signature.getC().gr(), publishedValues.getPt(), groupZpValues->p)
+                         * powm(gQt, signature.getC().rSt(), groupZpValues->p)) % groupZpValues->p;
+    return CheckContext(signature, publishedValues, grLtxt, createTheta(signature.getThetaPrim()));
+}
+
 CheckProcedureInput StepOutGroupSignaturesClientManager::createCheckProcedureInput(const unsigned int index,
                                                                                    const Signature& signature)
 {
@@ -82,6 +160,20 @@ InitializeSignatureInput StepOutGroupSignaturesClientManager::createInitializeSi
     return InitializeSignatureInput(*userIndex, message, randGen() % groupZpValues->p);
 }
 
+std::string StepOutGroupSignaturesClientManager::createMessageDigest(std::istream& message) const
+{
+    SHA256 hasher;
+    char block[4096];
+    while(message.read(block, sizeof(block)) || message.gcount() > 0)
+        hasher.setText(block, static_cast<std::size_t>(message.gcount()));
+    const unsigned char* hash = hasher.getHash();
+    std::ostringstream oss;
+    for(unsigned int i = 0; i < hasher.getHashLength(); ++i)
+        oss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(hash[i]);
+    BOOST_ASSERT(oss.str().size() == SGS::MESSAGE_DIGEST_LENGTH);
+    return oss.str();
+}
+
 JoinSignatureInput StepOutGroupSignaturesClientManager::createJoinSignatureInput(const BigInteger& t)
 {
     BOOST_ASSERT(userIndex);
@@ -164,6 +256,36 @@ const SignProcedureInput StepOutGroupSignaturesClientManager::createSignProcedur
     return SignProcedureInput(t, x, d, h);
 }
 
+void StepOutGroupSignaturesClientManager::createInterpolationCheck(const Signature& signature,
+                                                                   InterpolationCheck& check) const
+{
+    BigInteger xt = dummyUserPrivateKey->getX()(signature.getT(), groupZpValues->q);
+    BigInteger Pt = dummyUserPrivateKey->getP()(signature.getT(), groupZpValues->q);
+    BigInteger Qt = (dummyQ ? evaluationsCache.evaluate(*dummyQ, signature.getT(), groupZpValues->p)
+                            : evaluationsCache.evaluate(dummyUserPrivateKey->getQ(), signature.getT(), groupZpValues->p));
+    BigInteger grL = (powm(signature.getC().gr(), Pt, groupZpValues->p)
+                      * powm(Qt, signature.getC().rSt(), groupZpValues->p)) % groupZpValues->p;
+    Psi psi = createPsi(signature.getDelta(), createTheta(signature.getThetaPrim()), PsiElement(xt, grL));
+    std::vector<BigInteger> args;
+    BOOST_FOREACH(const PsiElement& psiElement, psi)
+    {
+        args.push_back(boost::get<0>(psiElement));
+        check.bases.push_back(boost::get<1>(psiElement));
+    }
+    check.exponents = PolynomialInTheExponentUtils::createLagrangeCoefficients(args, signature.getX(), groupZpValues->q);
+    check.grLtx = signature.getC().grLtx();
+}
+
+bool StepOutGroupSignaturesClientManager::createInterpolationCheckOfItem(const std::vector<BatchItem>& items,
+                                                                         std::vector<InterpolationCheck>& checks,
+                                                                         const std::size_t i) const
+{
+    if(!hasSubgroupValues(*items[i].second))
+        return false;
+    createInterpolationCheck(*items[i].second, checks[i]);
+    return true;
+}
+
 Theta StepOutGroupSignaturesClientManager::createTheta(const ThetaPrim& thetaPrim) const
 {
     Theta theta;
@@ -185,6 +307,21 @@ void StepOutGroupSignaturesClientManager::initializeUserKeys()
     randomizePolynomial(userPrivateKey->getX());
 }
 
+std::size_t StepOutGroupSignaturesClientManager::getElementWidth() const
+{
+    return (groupZpValues ? groupZpValues->p.getNumberOfBytes() : 0);
+}
+
+const PolynomialInTheExponentCache& StepOutGroupSignaturesClientManager::getEvaluationsCache() const
+{
+    return evaluationsCache;
+}
+
+const VerificationStatistics& StepOutGroupSignaturesClientManager::getVerificationStatistics() const
+{
+    return verificationStatistics;
+}
+
 std::string StepOutGroupSignaturesClientManager::getUserIndex() const
 {
     return (registered ? boost::lexical_cast<std::string>(*userIndex) : "?");
@@ -195,25 +332,31 @@ const Polynomial<SGS::X_POLYNOMIAL_DEGREE>& StepOutGroupSignaturesClientManager:
     return userPrivateKey->getX();
 }
 
-StepOutGroupSignaturesClientManager& StepOutGroupSignaturesClientManager::instance()
+bool StepOutGroupSignaturesClientManager::hasSubgroupValues(const Signature& signature) const
 {
-    return manager;
+    // Theta values are not covered by the server's signature, so a random
+    // combination of checks would not catch ones of an even order
+    BOOST_FOREACH(const ThetaElement& thetaElement, createTheta(signature.getThetaPrim()))
+    {
+        if(powm(boost::get<1>(thetaElement), groupZpValues->q, groupZpValues->p) != 1)
+            return false;
+    }
+    return true;
 }
 
 bool StepOutGroupSignaturesClientManager::isNotSigner(const UserPublicKey& publicKey,
                                                       const PublishedValues& publishedValues,
                                                       const Signature& signature) const
 {
-    if(isSigner(publicKey, publishedValues, signature))
-        return false;
-    BigInteger gQt = powm(publicKey.getQm()(publishedValues.getT(), groupZpValues->p),
-                          invm(publishedValues.getMt(), groupZpValues->q),
-                          groupZpValues->p);
-    BigInteger grLtxt = (powm(signature.getC().gr(), publishedValues.getPt(), groupZpValues->p)
-                         * powm(gQt, signature.getC().rSt(), groupZpValues->p)) % groupZpValues->p;
+    return (check(publicKey, publishedValues, signature) == CheckContext::NOT_SIGNER);
+}
+
+bool StepOutGroupSignaturesClientManager::isNotSigner(const CheckContext& context) const
+{
+    const Signature& signature = context.getSignature();
     Psi psi = createPsi(signature.getDelta(),
-                        createTheta(signature.getThetaPrim()),
-                        PsiElement(publishedValues.getXt(), grLtxt));
+                        context.getTheta(),
+                        PsiElement(context.getPublishedValues().getXt(), context.getGrLtxt()));
     std::vector<BigInteger> args, values;
     BOOST_FOREACH(const PsiElement& psiElement, psi)
     {
@@ -231,14 +374,45 @@ bool StepOutGroupSignaturesClientManager::isSigner(const UserPublicKey& publicKe
                                                    const PublishedValues& publishedValues,
                                                    const Signature& signature) const
 {
-    BigInteger gQt = powm(publicKey.getQm()(publishedValues.getT(), groupZpValues->p),
-                          invm(publishedValues.getMt(), groupZpValues->q),
-                          groupZpValues->p);
-    BigInteger grLtxt = (powm(signature.getC().gr(), publishedValues.getPt(), groupZpValues->p)
-                         * powm(gQt, signature.getC().rSt(), groupZpValues->p)) % groupZpValues->p;
-    ThetaElement thetaElement(publishedValues.getXt(), grLtxt);
-    Theta theta = createTheta(signature.getThetaPrim());
-    return (std::find(theta.begin(), theta.end(), thetaElement) != theta.end());
+    return isSigner(createCheckContext(publicKey, publishedValues, signature));
+}
+
+bool StepOutGroupSignaturesClientManager::isSigner(const CheckContext& context) const
+{
+    ThetaElement thetaElement(context.getPublishedValues().getXt(), context.getGrLtxt());
+    return (std::find(context.getTheta().begin(), context.getTheta().end(), thetaElement) != context.getTheta().end());
+}
+
+Signature StepOutGroupSignaturesClientManager::parseSignature(const std::string& serializedSignature) const
+{
+    const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+    Signature signature;
+    try
+    {
+        Utils::createObject(serializedSignature, signature);
+    }
+    catch(std::exception&)
+    {
+        verificationStatistics.record(VerificationStatistics::PARSE,
+                                      1,
+                                      1,
+                                      boost::posix_time::microsec_clock::universal_time() - start);
+        throw;
+    }
+    verificationStatistics.record(VerificationStatistics::PARSE,
+                                  1,
+                                  0,
+                                  boost::posix_time::microsec_clock::universal_time() - start);
+    return signature;
+}
+
+bool StepOutGroupSignaturesClientManager::parseSignatureOfItem(
+    const std::vector<SerializedSignedMessage>& signedMessages,
+    std::vector<Signature>& signatures,
+    const std::size_t i) const
+{
+    Utils::createObject(signedMessages[i].second, signatures[i]);
+    return true;
 }
 
 template<std::size_t D>
@@ -248,14 +422,96 @@ void StepOutGroupSignaturesClientManager::randomizePolynomial(Polynomial<D>& p_p
     std::for_each(p_poly.begin(), p_poly.end(), boost::bind(operator%, _1, groupZpValues->p));
 }
 
+std::vector<std::size_t> StepOutGroupSignaturesClientManager::runInParallel(const std::vector<std::size_t>& candidates,
+                                                                          const ItemTest& test,
+                                                                          std::size_t threads) const
+{
+    std::vector<char> passed(candidates.size(), false);
+    boost::atomic<std::size_t> nextItem(0);
+    if(threads == 0)
+        threads = std::max(boost::thread::hardware_concurrency(), 1u);
+    threads = std::min(threads, candidates.size());
+    boost::thread_group workers;
+    for(std::size_t i = 1; i < threads; ++i)
+        workers.create_thread(boost::bind(&StepOutGroupSignaturesClientManager::runItems,
+                                          this,
+                                          boost::cref(candidates),
+                                          boost::cref(test),
+                                          boost::ref(nextItem),
+                                          boost::ref(passed)));
+    runItems(candidates, test, nextItem, passed);
+    workers.join_all();
+    std::vector<std::size_t> accepted;
+    for(std::size_t i = 0; i < candidates.size(); ++i)
+    {
+        if(passed[i])
+            accepted.push_back(candidates[i]);
+    }
+    return accepted;
+}
+
+void StepOutGroupSignaturesClientManager::runItems(const std::vector<std::size_t>& candidates,
+                                                   const ItemTest& test,
+                                                   boost::atomic<std::size_t>& nextItem,
+                                                   std::vector<char>& passed) const
+{
+    for(std::size_t i = nextItem++; i < candidates.size(); i = nextItem++)
+    {
+        try
+        {
+            passed[i] = test(candidates[i]);
+        }
+        catch(std::exception&)
+        {
+            passed[i] = false;
+        }
+    }
+}
+
+bool StepOutGroupSignaturesClientManager::runStage(const VerificationStatistics::Stage stage,
+                                                   const boost::function<bool ()>& test) const
+{
+    const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+    bool passed = false;
+    try
+    {
+        passed = test();
+    }
+    catch(std::exception&)
+    {
+        verificationStatistics.record(stage, 1, 1, boost::posix_time::microsec_clock::universal_time() - start);
+        throw;
+    }
+    verificationStatistics.record(stage, 1, passed ? 0 : 1, boost::posix_time::microsec_clock::universal_time() - start);
+    return passed;
+}
+
+std::vector<std::size_t> StepOutGroupSignaturesClientManager::runStage(const VerificationStatistics::Stage stage,
+                                                                       const std::vector<std::size_t>& candidates,
+                                                                       const ItemTest& test,
+                                                                       const std::size_t threads) const
+{
+    const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+    std::vector<std::size_t> passed = runInParallel(candidates, test, threads);
+    verificationStatistics.record(stage,
+                                  candidates.size(),
+                                  candidates.size() - passed.size(),
+                                  boost::posix_time::microsec_clock::universal_time() - start);
+    return passed;
+}
+
 void StepOutGroupSignaturesClientManager::setDummyUserPrivateKey(const UserPrivateKey& dummyUserPrivateKey)
 {
     this->dummyUserPrivateKey.reset(new UserPrivateKey(dummyUserPrivateKey));
+    if(groupZpValues)
+        dummyQ.reset(new PrecomputedPolynomialInTheExponent<SGS::Q_POLYNOMIAL_DEGREE>(
+            dummyUserPrivateKey.getQ(), groupZpValues->p));
 }
 
 void StepOutGroupSignaturesClientManager::setGroupZpValues(const GroupZpValues& groupZpValuesInit)
 {
     groupZpValues.reset(new GroupZpValues(groupZpValuesInit));
+    dummyQ.reset();
 }
 
 void StepOutGroupSignaturesClientManager::setServerPublicKey(const IKey& serverPublicKeyInit)
@@ -269,26 +525,83 @@ void StepOutGroupSignaturesClientManager::setUserIndex(const unsigned int userIn
     registered = true;
 }
 
-bool StepOutGroupSignaturesClientManager::verifyInterpolation(const Signature& signature)
+bool StepOutGroupSignaturesClientManager::verifyInterpolation(const Signature& signature) const
 {
-    BigInteger xt = dummyUserPrivateKey->getX()(signature.getT(), groupZpValues->q);
-    BigInteger Pt = dummyUserPrivateKey->getP()(signature.getT(), groupZpValues->q);
-    BigInteger Qt = dummyUserPrivateKey->getQ()(signature.getT(), groupZpValues->p);
-    BigInteger grL = (powm(signature.getC().gr(), Pt, groupZpValues->p)
-                      * powm(Qt, signature.getC().rSt(), groupZpValues->p)) % groupZpValues->p;
-    Psi psi = createPsi(signature.getDelta(), createTheta(signature.getThetaPrim()), PsiElement(xt, grL));
-    std::vector<BigInteger> args, values;
-    BOOST_FOREACH(const PsiElement& psiElement, psi)
+    InterpolationCheck check;
+    createInterpolationCheck(signature, check);
+    return verifyInterpolation(check);
+}
+
+bool StepOutGroupSignaturesClientManager::verifyInterpolation(const InterpolationCheck& check) const
+{
+    return (PolynomialInTheExponentUtils::multiplyPowers(check.bases, check.exponents, groupZpValues->p) == check.grLtx);
+}
+
+bool StepOutGroupSignaturesClientManager::verifyInterpolationOfItem(const std::vector<BatchItem>& items,
+                                                                    const std::size_t i) const
+{
+    return verifyInterpolation(*items[i].second);
+}
+
+bool StepOutGroupSignaturesClientManager::verifyInterpolations(const std::vector<InterpolationCheck>& checks,
+                                                               CheckIterator first,
+                                                               CheckIterator last,
+                                                               const unsigned int soundnessBits) const
+{
+    std::vector<BigInteger> bases, exponents;
+    BigInteger::RandomGenerator generateExponent(soundnessBits);
+    for(CheckIterator it = first; it != last; ++it)
     {
-        args.push_back(boost::get<0>(psiElement));
-        values.push_back(boost::get<1>(psiElement));
+        const InterpolationCheck& check = checks[*it];
+        BigInteger e;
+        do
+            e = generateExponent();
+        while(e == 0);
+        for(std::size_t i = 0; i < check.bases.size(); ++i)
+        {
+            bases.push_back(check.bases[i]);
+            exponents.push_back((check.exponents[i] * e) % groupZpValues->q);
+        }
+        bases.push_back(check.grLtx);
+        exponents.push_back(groupZpValues->q - e);
     }
-    BigInteger grLPrim =
-        PolynomialInTheExponentUtils::interpolatePolynomialInPoint(args, values, signature.getX(), groupZpValues->p);
-    return (signature.getC().grLtx() == grLPrim);
+    return (PolynomialInTheExponentUtils::multiplyPowers(bases, exponents, groupZpValues->p) == 1);
 }
 
-bool StepOutGroupSignaturesClientManager::verifyMessageHash(const std::string& message, const Signature& signature)
+void StepOutGroupSignaturesClientManager::verifyInterpolations(const std::vector<InterpolationCheck>& checks,
+                                                               CheckIterator first,
+                                                               CheckIterator last,
+                                                               const unsigned int soundnessBits,
+                                                               std::vector<char>& results) const
+{
+    if(last - first == 1)
+    {
+        results[*first] = verifyInterpolation(checks[*first]);
+        return;
+    }
+    if(verifyInterpolations(checks, first, last, soundnessBits))
+    {
+        for(CheckIterator it = first; it != last; ++it)
+            results[*it] = true;
+        return;
+    }
+    CheckIterator middle = first + (last - first) / 2;
+    verifyInterpolations(checks, first, middle, soundnessBits, results);
+    verifyInterpolations(checks, middle, last, soundnessBits, results);
+}
+
+bool StepOutGroupSignaturesClientManager::verifyInterpolationsOfChunk(const std::vector<InterpolationCheck>& checks,
+                                                                      const std::vector<std::size_t>& prepared,
+                                                                      const unsigned int soundnessBits,
+                                                                      std::vector<char>& results,
+                                                                      const std::size_t first) const
+{
+    const std::size_t last = std::min(first + BATCH_SIZE, prepared.size());
+    verifyInterpolations(checks, prepared.begin() + first, prepared.begin() + last, soundnessBits, results);
+    return true;
+}
+
+bool StepOutGroupSignaturesClientManager::verifyMessageHash(const std::string& message, const Signature& signature) const
 {
     HMAC_SHA256 keyedHasher;
     keyedHasher.setKey(signature.getX().toString());
@@ -298,14 +611,130 @@ bool StepOutGroupSignaturesClientManager::verifyMessageHash(const std::string& m
     return (signature.getT() == tPrim);
 }
 
-bool StepOutGroupSignaturesClientManager::verifySignature(const std::string& message, const Signature& signature)
+bool StepOutGroupSignaturesClientManager::verifySignature(const std::string& message, const Signature& signature) const
+{
+    return (runStage(VerificationStatistics::MESSAGE_HASH,
+                     boost::bind(&StepOutGroupSignaturesClientManager::verifyMessageHash,
+                                 this,
+                                 boost::cref(message),
+                                 boost::cref(signature))) &&
+            runStage(VerificationStatistics::SIGMA,
+                     boost::bind(&StepOutGroupSignaturesClientManager::verifySigma,
+                                 this,
+                                 boost::cref(message),
+                                 boost::cref(signature))) &&
+            runStage(VerificationStatistics::INTERPOLATION,
+                     boost::bind(static_cast<bool (StepOutGroupSignaturesClientManager::*)(const Signature&) const>(
+                                     &StepOutGroupSignaturesClientManager::verifyInterpolation),
+                                 this,
+                                 boost::cref(signature))));
+}
+
+std::vector<bool> StepOutGroupSignaturesClientManager::verifyBatch(const std::vector<SignedMessage>& signedMessages,
+                                                                  std::size_t threads,
+                                                                  unsigned int soundnessBits) const
+{
+    checkSoundnessBits(soundnessBits);
+    std::vector<BatchItem> items;
+    std::vector<std::size_t> candidates;
+    for(std::size_t i = 0; i < signedMessages.size(); ++i)
+    {
+        items.push_back(BatchItem(&signedMessages[i].first, &signedMessages[i].second));
+        candidates.push_back(i);
+    }
+    return verifyBatchItems(items, candidates, threads, soundnessBits);
+}
+
+std::vector<bool> StepOutGroupSignaturesClientManager::verifyBatch(
+    const std::vector<SerializedSignedMessage>& signedMessages,
+    std::size_t threads,
+    unsigned int soundnessBits) const
 {
-    return (verifySigma(message, signature) &&
-            verifyMessageHash(message, signature) &&
-            verifyInterpolation(signature));
+    checkSoundnessBits(soundnessBits);
+    std::vector<std::size_t> candidates;
+    for(std::size_t i = 0; i < signedMessages.size(); ++i)
+        candidates.push_back(i);
+    std::vector<Signature> signatures(signedMessages.size());
+    candidates = runStage(VerificationStatistics::PARSE,
+                          candidates,
+                          boost::bind(&StepOutGroupSignaturesClientManager::parseSignatureOfItem,
+                                      this,
+                                      boost::cref(signedMessages),
+                                      boost::ref(signatures),
+                                      _1),
+                          threads);
+    std::vector<BatchItem> items;
+    for(std::size_t i = 0; i < signedMessages.size(); ++i)
+        items.push_back(BatchItem(&signedMessages[i].first, &signatures[i]));
+    return verifyBatchItems(items, candidates, threads, soundnessBits);
 }
 
-bool StepOutGroupSignaturesClientManager::verifySigma(const std::string& message, const Signature& signature)
+std::vector<bool> StepOutGroupSignaturesClientManager::verifyBatchItems(const std::vector<BatchItem>& items,
+                                                                       const std::vector<std::size_t>& candidates,
+                                                                       const std::size_t threads,
+                                                                       const unsigned int soundnessBits) const
+{
+    std::vector<std::size_t> passed = runStage(
+        VerificationStatistics::MESSAGE_HASH,
+        candidates,
+        boost::bind(&StepOutGroupSignaturesClientManager::testItem,
+                    this,
+                    &StepOutGroupSignaturesClientManager::verifyMessageHash,
+                    boost::cref(items),
+                    _1),
+        threads);
+    passed = runStage(VerificationStatistics::SIGMA,
+                      passed,
+                      boost::bind(&StepOutGroupSignaturesClientManager::testItem,
+                                  this,
+                                  &StepOutGroupSignaturesClientManager::verifySigma,
+                                  boost::cref(items),
+                                  _1),
+                      threads);
+    std::vector<char> results(items.size(), false);
+    if(soundnessBits == 0)
+    {
+        passed = runStage(VerificationStatistics::INTERPOLATION,
+                          passed,
+                          boost::bind(&StepOutGroupSignaturesClientManager::verifyInterpolationOfItem,
+                                      this,
+                                      boost::cref(items),
+                                      _1),
+                          threads);
+        BOOST_FOREACH(const std::size_t i, passed)
+            results[i] = true;
+        return std::vector<bool>(results.begin(), results.end());
+    }
+    const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+    std::vector<InterpolationCheck> checks(items.size());
+    const std::vector<std::size_t> prepared = runInParallel(
+        passed,
+        boost::bind(&StepOutGroupSignaturesClientManager::createInterpolationCheckOfItem,
+                    this,
+                    boost::cref(items),
+                    boost::ref(checks),
+                    _1),
+        threads);
+    std::vector<std::size_t> chunks;
+    for(std::size_t first = 0; first < prepared.size(); first += BATCH_SIZE)
+        chunks.push_back(first);
+    runInParallel(chunks,
+                  boost::bind(&StepOutGroupSignaturesClientManager::verifyInterpolationsOfChunk,
+                              this,
+                              boost::cref(checks),
+                              boost::cref(prepared),
+                              std::min(soundnessBits, groupZpValues->q.getNumberOfBits() - 1),
+                              boost::ref(results),
+                              _1),
+                  threads);
+    verificationStatistics.record(VerificationStatistics::INTERPOLATION,
+                                  passed.size(),
+                                  passed.size() - std::count(results.begin(), results.end(), true),
+                                  boost::posix_time::microsec_clock::universal_time() - start);
+    return std::vector<bool>(results.begin(), results.end());
+}
+
+bool StepOutGroupSignaturesClientManager::verifySigma(const std::string& message, const Signature& signature) const
 {
     std::string h = createH(message, signature.getThetaPrim());
     std::string strC = Utils::createString(signature.getC());
@@ -318,7 +747,14 @@ bool StepOutGroupSignaturesClientManager::verifySigma(const std::string& message
                                            *serverPublicKey);
 }
 
-std::string StepOutGroupSignaturesClientManager::createH(const std::string& message, const ThetaPrim& thetaPrim)
+bool StepOutGroupSignaturesClientManager::testItem(const SignedMessageTest test,
+                                                   const std::vector<BatchItem>& items,
+                                                   const std::size_t i) const
+{
+    return (this->*test)(*items[i].first, *items[i].second);
+}
+
+std::string StepOutGroupSignaturesClientManager::createH(const std::string& message, const ThetaPrim& thetaPrim) const
 {
     using namespace boost::assign;
     std::vector<BigInteger> xtValues;
@@ -38,6 +38,9 @@
 #include "../mpi/BigInteger.hpp"
 #include "../polynomial/Polynomial.hpp"
 #include "../polynomial_in_the_exponent/PolynomialInTheExponent.hpp"
+#include "../polynomial_in_the_exponent/PolynomialInTheExponentCache.hpp"
+#include "../polynomial_in_the_exponent/PrecomputedPolynomialInTheExponent.hpp"
+#include "CheckContext.hpp"
 #include "CheckProcedureInput.hpp"
 #include "CloseSignatureInput.hpp"
 #include "FinalizeSignatureInput.hpp"
@@ -57,13 +60,19 @@
 #include "ThetaPrim.hpp"
 #include "UserPrivateKey.hpp"
 #include "UserPublicKey.hpp"
+#include "VerificationStatistics.hpp"
 
+#include <boost/atomic.hpp>
+#include <boost/function.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include <cstddef>
+#include <istream>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 /**
  * StepOutGroupSignaturesClientManager class.
@@ -72,10 +81,69 @@
  * managing. It implements all methods needed by scheme
  * procedures such as signing, publishing, checking
  * or validating a signature.
+ *
+ * Every group member has an own instance keeping his keys
+ * and group parameters. The class isn't thread-safe, apart from
+ * verification and checking of signatures, which can be done
+ * by many threads at the same time.
  */
 class StepOutGroupSignaturesClientManager : private boost::noncopyable
 {
 public:
+    /**
+     * Constructor of the StepOutGroupSignaturesClientManager class.
+     *
+     * Creates a manager of a member who hasn't registered yet.
+     */
+    StepOutGroupSignaturesClientManager();
+
+    /**
+     * Message and its step-out group signature.
+     */
+    typedef std::pair<std::string, Signature> SignedMessage;
+
+    /**
+     * Message and its serialized step-out group signature.
+     */
+    typedef std::pair<std::string, std::string> SerializedSignedMessage;
+
+    /**
+     * User's public key and data published by the user.
+     */
+    typedef std::pair<UserPublicKey, PublishedValues> PublishedUser;
+
+    /**
+     * Checks whether a group member has created a given step-out group signature.
+     * Values needed by both the proof and the step-out procedure are
+     * calculated once.
+     *
+     * @param publicKey User's public key to check.
+     * @param publishedValues Data published by the user that is to be checked.
+     * @param signature Step-out group signature.
+     *
+     * @return Whether the user is an author of the signature, isn't one,
+     *         or has published values which are not real.
+     */
+    CheckContext::Result check(const UserPublicKey& publicKey,
+                               const PublishedValues& publishedValues,
+                               const Signature& signature) const;
+
+    /**
+     * Checks whether group members have created a given step-out group
+     * signature. Users are checked in parallel. A user whose check throws
+     * an exception, e.g. for lack of memory, is reported as unknown,
+     * as the failure isn't a proof of cheating.
+     *
+     * @param publishedUsers Public keys and published data of users to check.
+     * @param signature Step-out group signature.
+     * @param threads Number of threads checking users. Zero means one thread per core.
+     *
+     * @return For every user, in the same order: the result of the check.
+     */
+    std::vector<CheckContext::Result> checkAll(const std::vector<PublishedUser>& publishedUsers,
+                                               const Signature& signature,
+                                               std::size_t threads = 0) const;
+
     /**
      * Creates \c CheckProcedureInput object which includes data
      * needed to perform Check procedure.
@@ -117,6 +185,18 @@ public:
      */
     InitializeSignatureInput createInitializeSignatureInput(const std::string& message);
 
+    /**
+     * Calculates a digest of a message. The digest can be signed
+     * in place of the message, so neither the message has to be sent
+     * to Group Privacy Server nor it is kept there. The message
+     * is read in blocks, so its size doesn't matter.
+     *
+     * @param message Stream containing the message.
+     *
+     * @return SHA-256 of the message written as \c SGS::MESSAGE_DIGEST_LENGTH hexadecimal digits.
+     */
+    std::string createMessageDigest(std::istream& message) const;
+
     /**
      * Creates \c JoinSignatureInput object which includes data
      * needed to perform JoinSignature procedure.
@@ -166,6 +246,30 @@ public:
      */
     const SignProcedureInput createSignProcedureInput(const std::string& messageToSign);
 
+    /**
+     * Returns the number of bytes of elements of the group,
+     * i.e. of p, with which they are sent to the server.
+     *
+     * @return Number of bytes of group elements. Zero if group parameters haven't been set.
+     */
+    std::size_t getElementWidth() const;
+
+    /**
+     * Returns the cache of evaluated polynomials in the exponent
+     * Qm(t) and Q(t), e.g. to read its counters of hits and misses.
+     *
+     * @return Cache of evaluated polynomials in the exponent.
+     */
+    const PolynomialInTheExponentCache& getEvaluationsCache() const;
+
+    /**
+     * Returns numbers of signatures checked and rejected by every
+     * stage of verification and time spent in it.
+     *
+     * @return Statistics of verification.
+     */
+    const VerificationStatistics& getVerificationStatistics() const;
+
     /**
      * Returns user's index number assigned by Group Privacy Server
      * during registration procedure.
@@ -187,13 +291,6 @@ public:
      */
     void initializeUserKeys();
 
-    /**
-     * Return the only instance of the \c StepOutGroupSignaturesClientManager class.
-     *
-     * @return Instance of the \c StepOutGroupSignaturesClientManager class.
-     */
-    static StepOutGroupSignaturesClientManager& instance();
-
     /**
      * Checks whether a group member has created a given step-out group signature.
      *
@@ -221,14 +318,28 @@ public:
                   const Signature& signature) const;
 
     /**
-     * Sets the dummy user's private key.
+     * Deserializes a step-out group signature. This is the first stage
+     * of verification, and it is counted in the statistics as such.
+     *
+     * @param serializedSignature Serialized step-out group signature.
+     *
+     * @return Step-out group signature.
+     *
+     * @throws std::exception Thrown when the signature is malformed.
+     */
+    Signature parseSignature(const std::string& serializedSignature) const;
+
+    /**
+     * Sets the dummy user's private key. Powers of coefficients of
+     * the dummy user's Q(t) are precomputed if group values are set.
      *
      * @param dummyUserPrivateKey Dummy user's private key.
      */
     void setDummyUserPrivateKey(const UserPrivateKey& dummyUserPrivateKey);
 
     /**
-     * Sets group specific values (p, q and g).
+     * Sets group specific values (p, q and g). The dummy user's
+     * private key has to be set again after them.
      *
      * @param groupZpValuesInit group specific values.
      */
@@ -251,36 +362,165 @@ public:
 
     /**
      * Verifies whether a given step-out group signature matches
-     * the given message.
+     * the given message. Stages of verification are run from
+     * the cheapest one: t is compared with HMAC of the message,
+     * then the server's signature of C and Delta is verified,
+     * and finally the interpolation check of Theta is done.
+     * A stage rejecting the signature ends the verification.
      *
      * @param message A message.
      * @param signature Step-out group signature.
      *
      * @return True if the given step-out group signature is valid. False otherwise.
      */
-    bool verifySignature(const std::string& message, const Signature& signature);
+    bool verifySignature(const std::string& message, const Signature& signature) const;
+
+    /**
+     * Verifies many step-out group signatures at once. All signatures
+     * share group values and keys. Every stage of verification is run
+     * for all signatures in parallel, and only signatures accepted
+     * by a stage enter the next one. A signature whose verification
+     * throws an exception is not valid.
+     *
+     * With a non-zero soundness parameter, interpolation checks of many
+     * signatures are combined into a single one: each check is raised
+     * to a random non-zero exponent of \c soundnessBits bits and all of
+     * them are multiplied together. A batch containing an invalid signature
+     * passes with probability at most 1/(2^soundnessBits - 1), and a failed
+     * batch is bisected until the invalid signatures are found. Exponents
+     * are never longer than q, so the number of bits is capped one below
+     * the length of q.
+     *
+     * Exponents of combined checks are reduced modulo q, so they are as
+     * long as exponents of separate checks, and combining saves only
+     * squarings. Most of the time of the interpolation stage is spent
+     * preparing checks (evaluating the dummy user's Q(t) and Lagrange
+     * coefficients), which combining doesn't change. Both modes can
+     * be compared with \c tools/VerifyBatchBenchmark.cpp.
+     *
+     * @param signedMessages Messages and their step-out group signatures.
+     * @param threads Number of threads verifying signatures. Zero means one thread per core.
+     * @param soundnessBits Number of bits of random exponents. Zero means every signature is checked exactly.
+     *                      Otherwise at least \c MIN_SOUNDNESS_BITS.
+     *
+     * @return For every signature, in the same order: true if it is valid. False otherwise.
+     *
+     * @throws std::runtime_error Thrown when the soundness parameter is non-zero and too small.
+     */
+    std::vector<bool> verifyBatch(const std::vector<SignedMessage>& signedMessages,
+                                  std::size_t threads = 0,
+                                  unsigned int soundnessBits = 0) const;
+
+    /**
+     * Verifies many serialized step-out group signatures at once.
+     * Signatures are deserialized in parallel as the first stage
+     * of verification, and a malformed one is not valid.
+     *
+     * @param signedMessages Messages and their serialized step-out group signatures.
+     * @param threads Number of threads verifying signatures. Zero means one thread per core.
+     * @param soundnessBits Number of bits of random exponents. Zero means every signature is checked exactly.
+     *                      Otherwise at least \c MIN_SOUNDNESS_BITS.
+     *
+     * @return For every signature, in the same order: true if it is valid. False otherwise.
+     *
+     * @throws std::runtime_error Thrown when the soundness parameter is non-zero and too small.
+     */
+    std::vector<bool> verifyBatch(const std::vector<SerializedSignedMessage>& signedMessages,
+                                  std::size_t threads = 0,
+                                  unsigned int soundnessBits = 0) const;
 private:
-    StepOutGroupSignaturesClientManager();
-    std::string createH(const std::string& message, const ThetaPrim& thetaPrim);
+    /**
+     * Interpolation check of a signature: the product of bases
+     * raised to exponents must be equal to g^(rL(t,x)).
+     */
+    struct InterpolationCheck
+    {
+        std::vector<BigInteger> bases;
+        std::vector<BigInteger> exponents;
+        BigInteger              grLtx;
+    };
+
+    typedef std::vector<std::size_t>::const_iterator CheckIterator;
+    typedef std::pair<const std::string*, const Signature*> BatchItem;
+    typedef boost::function<bool (std::size_t)> ItemTest;
+    typedef bool (StepOutGroupSignaturesClientManager::*SignedMessageTest)(const std::string&, const Signature&) const;
+
+    static const std::size_t                     BATCH_SIZE = 64;   /**< Number of signatures whose interpolation checks are combined. */
+    static const unsigned int                    MIN_SOUNDNESS_BITS = 2;   /**< With one bit the only non-zero exponent would be 1. */
+
+    std::string createH(const std::string& message, const ThetaPrim& thetaPrim) const;
     Psi createPsi(const Delta& delta, const Theta& theta, const PsiElement& psiElement) const;
+    void checkAllItems(const std::vector<PublishedUser>& publishedUsers,
+                       const Signature& signature,
+                       boost::atomic<std::size_t>& nextItem,
+                       std::vector<CheckContext::Result>& results) const;
+    static void checkSoundnessBits(const unsigned int soundnessBits);
+    CheckContext createCheckContext(const UserPublicKey& publicKey,
+                                    const PublishedValues& publishedValues,
+                                    const Signature& signature) const;
+    void createInterpolationCheck(const Signature& signature, InterpolationCheck& check) const;
+    bool createInterpolationCheckOfItem(const std::vector<BatchItem>& items,
+                                        std::vector<InterpolationCheck>& checks,
+                                        const std::size_t i) const;
     Theta createTheta(const ThetaPrim& thetaPrim) const;
     ThetaElement createThetaElement(const ThetaPrimElement& thetaPrimElement) const;
     ThetaPrim createThetaPrim(const SignProcedureInput& input, const SignProcedureOutput& output);
+    bool hasSubgroupValues(const Signature& signature) const;
+    bool isNotSigner(const CheckContext& context) const;
+    bool isSigner(const CheckContext& context) const;
+    bool parseSignatureOfItem(const std::vector<SerializedSignedMessage>& signedMessages,
+                              std::vector<Signature>& signatures,
+                              const std::size_t i) const;
     template<std::size_t D>
     void randomizePolynomial(Polynomial<D>& p_poly);
-    bool verifyInterpolation(const Signature& signature);
-    bool verifyMessageHash(const std::string& message, const Signature& signature);
-    bool verifySigma(const std::string& message, const Signature& signature);
-
-    static StepOutGroupSignaturesClientManager   manager;
+    std::vector<std::size_t> runInParallel(const std::vector<std::size_t>& candidates,
+                                           const ItemTest& test,
+                                           std::size_t threads) const;
+    void runItems(const std::vector<std::size_t>& candidates,
+                  const ItemTest& test,
+                  boost::atomic<std::size_t>& nextItem,
+                  std::vector<char>& passed) const;
+    bool runStage(const VerificationStatistics::Stage stage, const boost::function<bool ()>& test) const;
+    std::vector<std::size_t> runStage(const VerificationStatistics::Stage stage,
+                                      const std::vector<std::size_t>& candidates,
+                                      const ItemTest& test,
+                                      const std::size_t threads) const;
+    bool testItem(const SignedMessageTest test, const std::vector<BatchItem>& items, const std::size_t i) const;
+    std::vector<bool> verifyBatchItems(const std::vector<BatchItem>& items,
+                                       const std::vector<std::size_t>& candidates,
+                                       const std::size_t threads,
+                                       const unsigned int soundnessBits) const;
+    bool verifyInterpolation(const Signature& signature) const;
+    bool verifyInterpolation(const InterpolationCheck& check) const;
+    bool verifyInterpolationOfItem(const std::vector<BatchItem>& items, const std::size_t i) const;
+    bool verifyInterpolations(const std::vector<InterpolationCheck>& checks,
+                              CheckIterator first,
+                              CheckIterator last,
+                              const unsigned int soundnessBits) const;
+    void verifyInterpolations(const std::vector<InterpolationCheck>& checks,
+                              CheckIterator first,
+                              CheckIterator last,
+                              const unsigned int soundnessBits,
+                              std::vector<char>& results) const;
+    bool verifyInterpolationsOfChunk(const std::vector<InterpolationCheck>& checks,
+                                     const std::vector<std::size_t>& prepared,
+                                     const unsigned int soundnessBits,
+                                     std::vector<char>& results,
+                                     const std::size_t first) const;
+    bool verifyMessageHash(const std::string& message, const Signature& signature) const;
+    bool verifySigma(const std::string& message, const Signature& signature) const;
 
     boost::shared_ptr<GroupZpValues>             groupZpValues;
     boost::shared_ptr<IKey>                      serverPublicKey;
     boost::shared_ptr<UserPrivateKey>            dummyUserPrivateKey;
+    boost::shared_ptr<PrecomputedPolynomialInTheExponent<SGS::Q_POLYNOMIAL_DEGREE> >
+                                                 dummyQ;   /**< The dummy user's Q(t) with powers of coefficients modulo p. */
     boost::shared_ptr<UserPrivateKey>            userPrivateKey;
     boost::shared_ptr<UserPublicKey>             userPublicKey;
     boost::shared_ptr<unsigned int>              userIndex;
     bool                                         registered;
+    mutable VerificationStatistics               verificationStatistics;   /**< Signatures checked and rejected by stages of verification. */
+    mutable PolynomialInTheExponentCache         evaluationsCache;   /**< Values of Qm(t) and Q(t) of recently used t. */
 };
 
 #endif // STEPOUTGROUPSIGNATURESCLIENTMANAGER_HPP
@@ -28,6 +28,7 @@
 #ifndef UTILS_HPP
 #define	UTILS_HPP
 
+#include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
 
 #include <sstream>
@@ -45,6 +46,20 @@ std::string createString(const Serializable& serializable)
     return ss.str();
 }
 
+/**
+ * Deserializes an object written by \c createString.
+ *
+ * @param string String containing the serialized object.
+ * @param serializable Object to deserialize to.
+ */
+template<typename Serializable>
+void createObject(const std::string& string, Serializable& serializable)
+{
+    std::stringstream ss(string);
+    boost::archive::text_iarchive ia(ss);
+    ia >> serializable;
+}
+
 } // namespace Utils
 
 #endif // UTILS_HPP
@@ -0,0 +1,72 @@
+/**
+ * @file VerificationStatistics.cpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains definitions of the methods from
+ * \c VerificationStatistics class.
+ */
+
+#include "VerificationStatistics.hpp"
+
+VerificationStatistics::VerificationStatistics()
+{
+    for(std::size_t stage = 0; stage < NUMBER_OF_STAGES; ++stage)
+    {
+        checked[stage] = 0;
+        rejected[stage] = 0;
+        microseconds[stage] = 0;
+    }
+}
+
+void VerificationStatistics::record(const Stage stage,
+                                    const std::size_t checkedInStage,
+                                    const std::size_t rejectedInStage,
+                                    const boost::posix_time::time_duration& duration)
+{
+    checked[stage] += checkedInStage;
+    rejected[stage] += rejectedInStage;
+    microseconds[stage] += duration.total_microseconds();
+}
+
+std::size_t VerificationStatistics::getChecked(const Stage stage) const
+{
+    return checked[stage];
+}
+
+std::size_t VerificationStatistics::getRejected(const Stage stage) const
+{
+    return rejected[stage];
+}
+
+boost::int64_t VerificationStatistics::getMicroseconds(const Stage stage) const
+{
+    return microseconds[stage];
+}
+
+const char* VerificationStatistics::getName(const Stage stage)
+{
+    static const char* const names[NUMBER_OF_STAGES] = {"parse", "message hash", "sigma", "interpolation"};
+    return names[stage];
+}
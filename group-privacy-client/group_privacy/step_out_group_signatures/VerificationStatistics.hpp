@@ -0,0 +1,107 @@
+/**
+ * @file VerificationStatistics.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains VerificationStatistics class which counts
+ * signatures checked and rejected by every stage of verification
+ * and time spent in it.
+ */
+
+#ifndef VERIFICATIONSTATISTICS_HPP
+#define	VERIFICATIONSTATISTICS_HPP
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+
+/**
+ * VerificationStatistics class.
+ *
+ * Verification of a signature is a sequence of stages ordered from
+ * the cheapest to the most expensive one, and a signature rejected
+ * by a stage doesn't enter the next ones. For every stage the class
+ * counts signatures which entered it, signatures rejected by it
+ * and time spent in it. Stages of a batch are run by many threads
+ * at once, so their time is the time the whole batch spent in them.
+ *
+ * The class is thread-safe.
+ */
+class VerificationStatistics : private boost::noncopyable
+{
+public:
+    /**
+     * Stage of verification.
+     */
+    enum Stage
+    {
+        PARSE,              /**< Deserialization of a signature. */
+        MESSAGE_HASH,       /**< Comparison of t with HMAC of the message. */
+        SIGMA,              /**< Verification of the server's signature of C and Delta. */
+        INTERPOLATION,      /**< Interpolation check of Theta. */
+        NUMBER_OF_STAGES
+    };
+
+    /**
+     * Constructor of the VerificationStatistics class.
+     *
+     * Creates statistics with all counters set to zero.
+     */
+    VerificationStatistics();
+
+    /**
+     * Adds results of a stage run for one or many signatures.
+     *
+     * @param stage Stage of verification.
+     * @param checked Number of signatures which entered the stage.
+     * @param rejected Number of signatures rejected by the stage.
+     * @param duration Time spent in the stage.
+     */
+    void record(const Stage stage,
+                const std::size_t checked,
+                const std::size_t rejected,
+                const boost::posix_time::time_duration& duration);
+
+    std::size_t getChecked(const Stage stage) const;
+    std::size_t getRejected(const Stage stage) const;
+    boost::int64_t getMicroseconds(const Stage stage) const;
+
+    /**
+     * Returns a name of a stage.
+     *
+     * @param stage Stage of verification.
+     *
+     * @return Name of the stage.
+     */
+    static const char* getName(const Stage stage);
+private:
+    boost::atomic<std::size_t>      checked[NUMBER_OF_STAGES];        /**< Numbers of signatures which entered stages. */
+    boost::atomic<std::size_t>      rejected[NUMBER_OF_STAGES];       /**< Numbers of signatures rejected by stages. */
+    boost::atomic<boost::int64_t>   microseconds[NUMBER_OF_STAGES];   /**< Time spent in stages. */
+};
+
+#endif // VERIFICATIONSTATISTICS_HPP
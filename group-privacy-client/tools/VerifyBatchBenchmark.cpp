@@ -0,0 +1,249 @@
+/**
+ * @file VerifyBatchBenchmark.cpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * This is a standalone benchmark of verification of many step-out
+ * group signatures. It is built from this file and all sources
+ * of Group Privacy Client except GroupPrivacyClient.cpp.
+ *
+ * Signatures are verified one by one, by verify-batch (exact
+ * interpolation checks) and by verify-batch-fast with several
+ * soundness parameters, in batches of growing sizes. Every batch
+ * is also verified with one signature whose interpolation check fails
+ * (its first grPt value, which the server's signature doesn't cover,
+ * is squared), so that the fast mode has to bisect it. Every run
+ * uses a new verifier with an empty cache of evaluations and one
+ * thread, and the best of a few runs is printed, in total and for
+ * the interpolation stage only.
+ */
+
+#include "../group_privacy/command/ParametersCache.hpp"
+#include "../group_privacy/command/SerializationUtils.hpp"
+#include "../group_privacy/step_out_group_signatures/GroupZpValues.hpp"
+#include "../group_privacy/step_out_group_signatures/ParametersBundle.hpp"
+#include "../group_privacy/step_out_group_signatures/StepOutGroupSignaturesClientManager.hpp"
+#include "../group_privacy/step_out_group_signatures/Utils.hpp"
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+typedef StepOutGroupSignaturesClientManager::SerializedSignedMessage SerializedSignedMessage;
+
+/**
+ * Reads a whole file.
+ *
+ * @param filename Name of the file.
+ *
+ * @return Content of the file.
+ */
+static std::string readFile(const std::string& filename)
+{
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if(!file.is_open())
+        throw std::runtime_error("File \'" + filename + "\' doesn't exist!");
+    std::ostringstream oss;
+    oss << file.rdbuf();
+    return oss.str();
+}
+
+/**
+ * Creates a signature which passes all stages of verification
+ * but the interpolation check.
+ *
+ * @param serializedSignature Serialized valid signature.
+ * @param p Modulus of the group.
+ *
+ * @return Serialized invalid signature.
+ */
+static std::string createInvalidSignature(const std::string& serializedSignature, const BigInteger& p)
+{
+    StepOutGroupSignaturesClientManager parser;
+    Signature signature = parser.parseSignature(serializedSignature);
+    BigInteger& grPt = signature.getThetaPrim().at(0).grPt();
+    grPt = (grPt * grPt) % p;
+    return Utils::createString(signature);
+}
+
+/**
+ * Reads the modulus of the group from a bundle.
+ *
+ * @param bundleFilename Name of the file containing the bundle.
+ *
+ * @return Modulus of the group.
+ */
+static BigInteger readModulus(const std::string& bundleFilename)
+{
+    Utils::Reader reader(readFile(bundleFilename));
+    ParametersBundle bundle;
+    reader >> bundle;
+    Utils::Reader parameters(bundle.getParameters());
+    GroupZpValues groupZpValues;
+    parameters >> groupZpValues;
+    return groupZpValues.p;
+}
+
+/**
+ * Verifies a batch with a new verifier.
+ *
+ * @param bundleFilename Name of the file containing parameters exported by the server.
+ * @param trustedFingerprint Fingerprint of the parameters.
+ * @param batch Messages and their serialized signatures.
+ * @param soundnessBits Soundness parameter of verify-batch-fast, zero for verify-batch.
+ * @param separately True if signatures are to be verified one by one.
+ * @param valid Number of valid signatures.
+ * @param interpolation Microseconds of the interpolation stage.
+ *
+ * @return Microseconds of verification.
+ */
+static long verify(const std::string& bundleFilename,
+                   const std::string& trustedFingerprint,
+                   const std::vector<SerializedSignedMessage>& batch,
+                   const unsigned int soundnessBits,
+                   const bool separately,
+                   std::size_t& valid,
+                   long& interpolation)
+{
+    StepOutGroupSignaturesClientManager verifier;
+    ParametersCache::loadBundle(verifier, bundleFilename, trustedFingerprint);
+    std::vector<bool> results;
+    const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+    if(separately)
+    {
+        for(std::size_t i = 0; i < batch.size(); ++i)
+        {
+            try
+            {
+                results.push_back(verifier.verifySignature(batch[i].first, verifier.parseSignature(batch[i].second)));
+            }
+            catch(std::exception&)
+            {
+                results.push_back(false);
+            }
+        }
+    }
+    else
+        results = verifier.verifyBatch(batch, 1, soundnessBits);
+    const long microseconds = (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds();
+    valid = std::count(results.begin(), results.end(), true);
+    interpolation = verifier.getVerificationStatistics().getMicroseconds(VerificationStatistics::INTERPOLATION);
+    return microseconds;
+}
+
+/**
+ * The main() function of the benchmark.
+ *
+ * Usage: VerifyBatchBenchmark bundle fingerprint list [runs]
+ *
+ * The list contains names of messages and their signatures
+ * in pairs, as for verify-batch. Signatures should be distinct,
+ * otherwise cached evaluations make repeated ones cheaper.
+ *
+ * @param argc Number of arguments.
+ * @param argv An array of arguments.
+ * @return Error identifier (zero if the benchmark has been run).
+ */
+int main(int argc, char* argv[])
+{
+    if(argc < 4)
+    {
+        std::cerr << "Usage: " << argv[0] << " bundle fingerprint list [runs]" << std::endl;
+        return 1;
+    }
+    const std::string bundleFilename(argv[1]);
+    const std::string trustedFingerprint(argv[2]);
+    try
+    {
+        const unsigned int runs = (argc > 4 ? boost::lexical_cast<unsigned int>(argv[4]) : 3);
+        const BigInteger p = readModulus(bundleFilename);
+        std::ifstream list(argv[3]);
+        std::vector<SerializedSignedMessage> signedMessages;
+        std::string messageFilename, signatureFilename;
+        while(list >> messageFilename >> signatureFilename)
+            signedMessages.push_back(SerializedSignedMessage(readFile(messageFilename), readFile(signatureFilename)));
+        if(signedMessages.empty())
+            throw std::runtime_error("No signatures in \'" + std::string(argv[3]) + "\'!");
+
+        const unsigned int SOUNDNESS_BITS[] = {0, 10, 20, 40};
+        std::cout << "size invalid mode                     valid   total [ms]   interpolation [ms]   per signature [ms]"
+                  << std::endl;
+        for(std::size_t size = 1; size <= signedMessages.size(); size *= 4)
+        {
+            for(int invalid = 0; invalid < 2; ++invalid)
+            {
+                std::vector<SerializedSignedMessage> batch(signedMessages.begin(), signedMessages.begin() + size);
+                if(invalid)
+                    batch[size / 2].second = createInvalidSignature(batch[size / 2].second, p);
+                for(int mode = -1; mode < 4; ++mode)
+                {
+                    long best = -1, bestInterpolation = -1;
+                    std::size_t valid = 0;
+                    for(unsigned int run = 0; run < runs; ++run)
+                    {
+                        long interpolation;
+                        const long microseconds = verify(bundleFilename,
+                                                         trustedFingerprint,
+                                                         batch,
+                                                         (mode < 0 ? 0 : SOUNDNESS_BITS[mode]),
+                                                         mode < 0,
+                                                         valid,
+                                                         interpolation);
+                        if(best < 0 || microseconds < best)
+                            best = microseconds;
+                        if(bestInterpolation < 0 || interpolation < bestInterpolation)
+                            bestInterpolation = interpolation;
+                    }
+                    std::string name = "one by one";
+                    if(mode == 0)
+                        name = "verify-batch";
+                    else if(mode > 0)
+                        name = "verify-batch-fast " + boost::lexical_cast<std::string>(SOUNDNESS_BITS[mode]);
+                    std::cout << std::setw(4) << size << " " << std::setw(7) << invalid << " "
+                              << std::left << std::setw(24) << name << std::right << " "
+                              << std::setw(5) << valid << " "
+                              << std::fixed << std::setprecision(1)
+                              << std::setw(12) << best / 1000.0 << " "
+                              << std::setw(20) << bestInterpolation / 1000.0 << " "
+                              << std::setw(20) << best / 1000.0 / size << std::endl;
+                }
+            }
+        }
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
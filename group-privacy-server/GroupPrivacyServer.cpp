@@ -29,32 +29,119 @@
  */
 
 #include "group_privacy/manager/GroupPrivacyServerManager.hpp"
+#include "group_privacy/manager/SessionLimits.hpp"
+#include "group_privacy/step_out_group_signatures/StepOutGroupSignaturesManager.hpp"
 
 #include <boost/asio.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
 
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
 #include <cstdlib>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Parses a numeric command line argument.
+ *
+ * @param p_text Text of the argument.
+ * @param p_name Name of the argument used in the error message.
+ * @param p_min Minimal allowed value.
+ * @param p_max Maximal allowed value.
+ *
+ * @return Value of the argument.
+ *
+ * @throw std::invalid_argument If the argument isn't a number or is out of range.
+ */
+static long parseNumber(const char* p_text, const std::string& p_name, const long p_min, const long p_max = LONG_MAX)
+{
+    char* end = NULL;
+    errno = 0;
+    const long value = std::strtol(p_text, &end, 10);
+    if(end == p_text || *end != '\0' || errno == ERANGE || value < p_min || value > p_max)
+        throw std::invalid_argument("Invalid " + p_name + ": " + p_text);
+    return value;
+}
 
 /**
  * The main() function of Group Privacy Server.
  *
- * Sets a port number and initializes a manager
- * which handles all connections.
+ * Sets a port number, initializes a manager
+ * which handles all connections and runs
+ * the given number of threads which serve them.
+ * If a socket path is given, local clients may
+ * also connect through it. Timeouts are given in seconds,
+ * zero means no timeout. Completed signatures are kept
+ * for signature-retention seconds, zero means forever.
+ * Requests longer than max-request-size bytes are refused,
+ * so bigger messages have to be signed in digest mode.
+ *
+ * Usage: GroupPrivacyServer [port [threads [max-sessions [socket-path
+ *                           [idle-timeout [request-timeout [max-queued-requests
+ *                           [write-timeout [max-session-requests
+ *                           [signature-retention [max-request-size]]]]]]]]]]]
  *
  * @param argc Number of arguments.
  * @param argv An array of arguments.
- * @return Error identifier (always zero).
+ * @return Error identifier (zero if the arguments are valid).
  */
 int main(int argc, char* argv[])
 {
     const int DEFAULT_PORT = 31337;
-    int port = (argc == 1 ? DEFAULT_PORT : std::atoi(argv[1]));
+    int port = DEFAULT_PORT;
+    std::size_t threads = boost::thread::hardware_concurrency();
+    std::string localPath = (argc < 5 ? std::string() : std::string(argv[4]));
+    SessionLimits limits;
+    long signatureRetention = SGS::COMPLETED_SIGNATURE_RETENTION;
+    try
+    {
+        if(argc > 1)
+            port = parseNumber(argv[1], "port", 0, 65535);
+        if(argc > 2)
+            threads = parseNumber(argv[2], "number of threads", 1);
+        if(argc > 3)
+            limits.maxSessions = parseNumber(argv[3], "max-sessions", 1);
+        if(argc > 5)
+            limits.idleTimeout = parseNumber(argv[5], "idle-timeout", 0);
+        if(argc > 6)
+            limits.requestTimeout = parseNumber(argv[6], "request-timeout", 0);
+        if(argc > 7)
+            limits.maxQueuedRequests = parseNumber(argv[7], "max-queued-requests", 1);
+        if(argc > 8)
+            limits.writeTimeout = parseNumber(argv[8], "write-timeout", 0);
+        if(argc > 9)
+            limits.maxSessionRequests = parseNumber(argv[9], "max-session-requests", 1);
+        if(argc > 10)
+            signatureRetention = parseNumber(argv[10], "signature-retention", 0);
+        if(argc > 11)
+            limits.maxRequestSize = parseNumber(argv[11], "max-request-size", 1);
+    }
+    catch(std::invalid_argument& e)
+    {
+        std::cerr << e.what() << std::endl;
+        std::cerr << "Usage: " << argv[0] << " [port [threads [max-sessions [socket-path [idle-timeout"
+                  << " [request-timeout [max-queued-requests [write-timeout [max-session-requests"
+                  << " [signature-retention [max-request-size]]]]]]]]]]]"
+                  << std::endl;
+        return 1;
+    }
+    threads = std::max<std::size_t>(threads, 1);
     std::cout << "Starting server on port " << port << "." << std::endl;
+    if(!localPath.empty())
+        std::cout << "Listening on local socket " << localPath << "." << std::endl;
     try
     {
+        StepOutGroupSignaturesManager::instance().setSignatureRetention(signatureRetention);
         boost::asio::io_service service;
-        GroupPrivacyServerManager l_manager(service, port);
-        service.run();
+        GroupPrivacyServerManager l_manager(service, port, localPath, limits);
+        boost::thread_group l_threads;
+        for(std::size_t i = 0; i < threads; ++i)
+            l_threads.create_thread(boost::bind(&boost::asio::io_service::run, &service));
+        l_threads.join_all();
     }
     catch(std::exception& e)
     {
@@ -1,5 +1,5 @@
 /**
- * @file VerifyCommand.hpp
+ * @file CalculatePQCommand.hpp
  * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
  * @version 1.0
  *
@@ -25,22 +25,19 @@
  * @section DESCRIPTION
  */
 
-#ifndef VERIFYCOMMAND_HPP
-#define	VERIFYCOMMAND_HPP
+#ifndef CALCULATEPQCOMMAND_HPP
+#define	CALCULATEPQCOMMAND_HPP
 
 #include "../step_out_group_signatures/StepOutGroupSignaturesManager.hpp"
 #include "ICommand.hpp"
 
-#include <boost/asio.hpp>
-#include <boost/shared_ptr.hpp>
-
-class VerifyCommand : public ICommand
+class CalculatePQCommand : public ICommand
 {
 public:
-    VerifyCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
-    void execute();
+    CalculatePQCommand();
+    Payload execute(Utils::Reader& request) const;
 private:
-    StepOutGroupSignaturesManager&   stepOutGroupSignaturesManager;   /**< Manager of step-out group signatures. */
+    StepOutGroupSignaturesManager& stepOutGroupSignaturesManager; /**< Manager of step-out group signatures. */
 };
 
-#endif // VERIFYCOMMAND_HPP
+#endif // CALCULATEPQCOMMAND_HPP
@@ -31,28 +31,27 @@
 #include "../step_out_group_signatures/PublishProcedureInput.hpp"
 #include "SerializationUtils.hpp"
 
-CheckCommand::CheckCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket),
-      stepOutGroupSignaturesManager(StepOutGroupSignaturesManager::instance())
+#include <boost/optional.hpp>
+
+CheckCommand::CheckCommand()
+    : stepOutGroupSignaturesManager(StepOutGroupSignaturesManager::instance())
 {
 }
 
-void CheckCommand::execute()
+ICommand::Payload CheckCommand::execute(Utils::Reader& request) const
 {
     std::cout << "CheckCommand::execute() started" << std::endl;
-    send("ok");
-    CheckProcedureInput checkProcedureInput = receive<CheckProcedureInput>();
-    if(stepOutGroupSignaturesManager.hasPublishedValues(checkProcedureInput))
-    {
-        send(std::string("yes"));
-        receive<std::string>();
-        send(stepOutGroupSignaturesManager.getUserPublicKey(checkProcedureInput.getUserIndex()));
-        receive<std::string>();
-        send(stepOutGroupSignaturesManager.getPublishedValues(checkProcedureInput));
-    }
-    else
-        send(std::string("no"));
+    Utils::Writer response(stepOutGroupSignaturesManager.getElementWidth());
+    CheckProcedureInput checkProcedureInput;
+    request >> checkProcedureInput;
+    boost::optional<PublishedValues> publishedValues =
+        stepOutGroupSignaturesManager.findPublishedValues(checkProcedureInput);
+    response << static_cast<bool>(publishedValues);
+    if(publishedValues)
+        response << stepOutGroupSignaturesManager.getUserPublicKey(checkProcedureInput.getUserIndex())
+                 << *publishedValues;
     std::cout << "CheckCommand::execute() finished" << std::endl;
+    return share(response);
 
 //    std::cout << "CheckCommand::execute() started" << std::endl;
 //    socketManager.send("ok");
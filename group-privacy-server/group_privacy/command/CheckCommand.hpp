@@ -31,14 +31,12 @@
 #include "../step_out_group_signatures/StepOutGroupSignaturesManager.hpp"
 #include "ICommand.hpp"
 
-#include <boost/asio.hpp>
-#include <boost/shared_ptr.hpp>
 
 class CheckCommand : public ICommand
 {
 public:
-    CheckCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
-    void execute();
+    CheckCommand();
+    Payload execute(Utils::Reader& request) const;
 private:
     StepOutGroupSignaturesManager& stepOutGroupSignaturesManager; /**< Manager of step-out group signatures. */
 };
@@ -31,17 +31,17 @@
 
 #include <iostream>
 
-CloseSignatureCommand::CloseSignatureCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket),
-      stepOutGroupSignaturesManager(StepOutGroupSignaturesManager::instance())
+CloseSignatureCommand::CloseSignatureCommand()
+    : stepOutGroupSignaturesManager(StepOutGroupSignaturesManager::instance())
 {
 }
 
-void CloseSignatureCommand::execute()
+ICommand::Payload CloseSignatureCommand::execute(Utils::Reader& request) const
 {
     std::cout << "CloseSignatureCommand::execute() started" << std::endl;
-    send(std::string("ok"));
-    CloseSignatureInput input = receive<CloseSignatureInput>();
+    CloseSignatureInput input;
+    request >> input;
     stepOutGroupSignaturesManager.closeSignature(input);
     std::cout << "CloseSignatureCommand::execute() finished" << std::endl;
+    return Payload();
 }
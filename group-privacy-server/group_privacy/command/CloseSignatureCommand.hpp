@@ -34,8 +34,8 @@
 class CloseSignatureCommand : public ICommand
 {
 public:
-    CloseSignatureCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
-    void execute();
+    CloseSignatureCommand();
+    Payload execute(Utils::Reader& request) const;
 private:
     StepOutGroupSignaturesManager& stepOutGroupSignaturesManager; /**< Manager of step-out group signatures. */
 };
@@ -0,0 +1,68 @@
+/**
+ * @file CommandTable.cpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ */
+
+#include "CommandTable.hpp"
+
+#include "Commands.hpp"
+
+boost::once_flag CommandTable::tableFlag = BOOST_ONCE_INIT;
+const CommandTable* CommandTable::table = 0;
+
+CommandTable::CommandTable()
+{
+    commands[Envelope::CALCULATE_PQ].reset(new CalculatePQCommand());
+    commands[Envelope::CHECK].reset(new CheckCommand());
+    commands[Envelope::CLOSE_SIGNATURE].reset(new CloseSignatureCommand());
+    commands[Envelope::FINALIZE_SIGNATURE].reset(new FinalizeSignatureCommand());
+    commands[Envelope::GET_FINALIZE_SIGNATURE_INPUT].reset(new GetFinalizeSignatureInputCommand());
+    commands[Envelope::GET_PARAMETERS].reset(new GetParametersCommand());
+    commands[Envelope::GET_PARAMETERS_FINGERPRINT].reset(new GetParametersCommand(GetParametersCommand::FINGERPRINT));
+    commands[Envelope::GET_PARAMETERS_BUNDLE].reset(new GetParametersCommand(GetParametersCommand::BUNDLE));
+    commands[Envelope::CHECK_ALL].reset(new CheckAllCommand());
+    commands[Envelope::GET_SIGNATURE].reset(new GetSignatureCommand());
+    commands[Envelope::GET_T].reset(new GetTCommand());
+    commands[Envelope::INITIALIZE_SIGNATURE].reset(new InitializeSignatureCommand());
+    commands[Envelope::INITIALIZE_SIGNATURE_DIGEST].reset(new InitializeSignatureCommand(true));
+    commands[Envelope::JOIN_SIGNATURE].reset(new JoinSignatureCommand());
+    commands[Envelope::PUBLISH].reset(new PublishCommand());
+    commands[Envelope::QUIT].reset(new QuitCommand());
+    commands[Envelope::REGISTER].reset(new RegisterCommand());
+    commands[Envelope::SIGN].reset(new SignCommand());
+}
+
+const ICommand* CommandTable::find(const unsigned int operation)
+{
+    boost::call_once(tableFlag, &CommandTable::create);
+    if(operation >= table->commands.size())
+        return 0;
+    return table->commands[operation].get();
+}
+
+void CommandTable::create()
+{
+    table = new CommandTable();
+}
@@ -0,0 +1,72 @@
+/**
+ * @file CommandTable.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains CommandTable class which dispatches
+ * requests to commands by codes of operations.
+ */
+
+#ifndef COMMANDTABLE_HPP
+#define	COMMANDTABLE_HPP
+
+#include "Envelope.hpp"
+#include "ICommand.hpp"
+
+#include <boost/array.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/once.hpp>
+
+/**
+ * CommandTable class.
+ *
+ * Holds one command for every operation, indexed by the operation's
+ * code. Commands are stateless, so the only table is shared by all
+ * sessions and never changes after it is created. It is created when
+ * the first request is dispatched, after the step-out group signatures
+ * manager has been initialized.
+ */
+class CommandTable : private boost::noncopyable
+{
+public:
+    /**
+     * Finds the command which handles a given operation.
+     *
+     * @param operation Code of the operation.
+     *
+     * @return The command or null if the operation is unknown.
+     */
+    static const ICommand* find(const unsigned int operation);
+private:
+    CommandTable();
+    static void create();
+
+    static boost::once_flag      tableFlag;   /**< Guards creation of the table. */
+    static const CommandTable*   table;       /**< The only instance of the class. */
+
+    boost::array<boost::shared_ptr<const ICommand>, Envelope::NUMBER_OF_OPERATIONS> commands;   /**< Commands indexed by codes of operations. */
+};
+
+#endif // COMMANDTABLE_HPP
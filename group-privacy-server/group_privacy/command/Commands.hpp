@@ -28,16 +28,20 @@
 #ifndef COMMANDS_HPP
 #define	COMMANDS_HPP
 
+#include "CalculatePQCommand.hpp"
+#include "CheckAllCommand.hpp"
 #include "CheckCommand.hpp"
 #include "CloseSignatureCommand.hpp"
 #include "FinalizeSignatureCommand.hpp"
+#include "GetFinalizeSignatureInputCommand.hpp"
+#include "GetParametersCommand.hpp"
 #include "GetSignatureCommand.hpp"
+#include "GetTCommand.hpp"
 #include "InitializeSignatureCommand.hpp"
 #include "JoinSignatureCommand.hpp"
 #include "PublishCommand.hpp"
 #include "QuitCommand.hpp"
 #include "RegisterCommand.hpp"
 #include "SignCommand.hpp"
-#include "VerifyCommand.hpp"
 
 #endif // COMMANDS_HPP
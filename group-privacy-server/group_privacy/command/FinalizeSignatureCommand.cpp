@@ -30,24 +30,21 @@
 #include "../step_out_group_signatures/FinalizeSignatureInput.hpp"
 #include "../step_out_group_signatures/FinalizeSignatureOutput.hpp"
 
-#include <boost/lexical_cast.hpp>
-
 #include <iostream>
 #include <string>
 
-FinalizeSignatureCommand::FinalizeSignatureCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket),
-      stepOutGroupSignaturesManager(StepOutGroupSignaturesManager::instance())
+FinalizeSignatureCommand::FinalizeSignatureCommand()
+    : stepOutGroupSignaturesManager(StepOutGroupSignaturesManager::instance())
 {
 }
 
-void FinalizeSignatureCommand::execute()
+ICommand::Payload FinalizeSignatureCommand::execute(Utils::Reader& request) const
 {
     std::cout << "FinalizeSignatureCommand::execute() started" << std::endl;
-    send(std::string("ok"));
-    unsigned int signatureIndex = boost::lexical_cast<unsigned int>(receive<std::string>());
-    send(stepOutGroupSignaturesManager.createFinalizeSignatureInput(signatureIndex));
-    FinalizeSignatureOutput output = receive<FinalizeSignatureOutput>();
+    unsigned int signatureIndex;
+    FinalizeSignatureOutput output;
+    request >> signatureIndex >> output;
     stepOutGroupSignaturesManager.finalizeSignature(signatureIndex, output);
     std::cout << "FinalizeSignatureCommand::execute() finished" << std::endl;
+    return Payload();
 }
@@ -34,8 +34,8 @@
 class FinalizeSignatureCommand : public ICommand
 {
 public:
-    FinalizeSignatureCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
-    void execute();
+    FinalizeSignatureCommand();
+    Payload execute(Utils::Reader& request) const;
 private:
     StepOutGroupSignaturesManager& stepOutGroupSignaturesManager; /**< Manager of step-out group signatures. */
 };
@@ -0,0 +1,83 @@
+/**
+ * @file GetParametersCommand.cpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ */
+
+#include "GetParametersCommand.hpp"
+
+#include "../hash/SHA256.hpp"
+#include "SerializationUtils.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+boost::once_flag GetParametersCommand::parametersFlag = BOOST_ONCE_INIT;
+ICommand::Payload GetParametersCommand::parameters;
+ICommand::Payload GetParametersCommand::fingerprint;
+ICommand::Payload GetParametersCommand::bundle;
+
+GetParametersCommand::GetParametersCommand(const Content content)
+    : content(content)
+{
+    boost::call_once(parametersFlag, &GetParametersCommand::serializeParameters);
+}
+
+ICommand::Payload GetParametersCommand::execute(Utils::Reader&) const
+{
+    std::cout << "GetParametersCommand::execute() started" << std::endl;
+    std::cout << "GetParametersCommand::execute() finished" << std::endl;
+    switch(content)
+    {
+        case FINGERPRINT:
+            return fingerprint;
+        case BUNDLE:
+            return bundle;
+        default:
+            return parameters;
+    }
+}
+
+void GetParametersCommand::serializeParameters()
+{
+    StepOutGroupSignaturesManager& stepOutGroupSignaturesManager = StepOutGroupSignaturesManager::instance();
+    Utils::Writer response(stepOutGroupSignaturesManager.getElementWidth());
+    response << stepOutGroupSignaturesManager.getGroupZpValues()
+             << stepOutGroupSignaturesManager.getServerPublicKey()
+             << stepOutGroupSignaturesManager.getDummyUserPrivateKey();
+    parameters = share(response);
+    SHA256 hasher;
+    hasher.setText(*parameters);
+    const unsigned char* digest = hasher.getHash();
+    std::ostringstream oss;
+    for(unsigned int i = 0; i < hasher.getHashLength(); ++i)
+        oss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(digest[i]);
+    Utils::Writer hash;
+    hash << oss.str();
+    fingerprint = share(hash);
+    Utils::Writer signedBundle;
+    signedBundle << stepOutGroupSignaturesManager.createParametersBundle(*parameters);
+    bundle = share(signedBundle);
+}
@@ -0,0 +1,77 @@
+/**
+ * @file GetParametersCommand.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ */
+
+#ifndef GETPARAMETERSCOMMAND_HPP
+#define	GETPARAMETERSCOMMAND_HPP
+
+#include "../step_out_group_signatures/StepOutGroupSignaturesManager.hpp"
+#include "ICommand.hpp"
+
+#include <boost/thread/once.hpp>
+
+/**
+ * GetParametersCommand class.
+ *
+ * Group values, the server's public key and the dummy user's
+ * private key never change after the server starts, so they are
+ * serialized once, by the first command created, and every
+ * response shares the same buffer.
+ *
+ * Clients cache the parameters, so the command can also send
+ * their fingerprint only: SHA-256 of the serialized parameters.
+ * A new group is generated whenever the server starts, so the
+ * fingerprint changes with it. The parameters can also be sent
+ * as a bundle signed with the server's private key, which lets
+ * clients verify signatures without connecting to the server.
+ */
+class GetParametersCommand : public ICommand
+{
+public:
+    /**
+     * Content of responses.
+     */
+    enum Content
+    {
+        PARAMETERS,
+        FINGERPRINT,
+        BUNDLE
+    };
+
+    GetParametersCommand(const Content content = PARAMETERS);
+    Payload execute(Utils::Reader& request) const;
+private:
+    static void serializeParameters();
+
+    static boost::once_flag   parametersFlag;   /**< Guards serialization of the parameters. */
+    static Payload            parameters;       /**< Serialized parameters. */
+    static Payload            fingerprint;      /**< Serialized fingerprint of the parameters. */
+    static Payload            bundle;           /**< Serialized signed bundle of the parameters. */
+
+    const Content             content;          /**< Content of responses. */
+};
+
+#endif // GETPARAMETERSCOMMAND_HPP
@@ -27,22 +27,20 @@
 
 #include "GetSignatureCommand.hpp"
 
-#include <boost/lexical_cast.hpp>
-
 #include <iostream>
 #include <string>
 
-GetSignatureCommand::GetSignatureCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket),
-      stepOutGroupSignaturesManager(StepOutGroupSignaturesManager::instance())
+GetSignatureCommand::GetSignatureCommand()
+    : stepOutGroupSignaturesManager(StepOutGroupSignaturesManager::instance())
 {
 }
 
-void GetSignatureCommand::execute()
+ICommand::Payload GetSignatureCommand::execute(Utils::Reader& request) const
 {
     std::cout << "GetSignatureCommand::execute() started" << std::endl;
-    send(std::string("ok"));
-    unsigned int signatureIndex = boost::lexical_cast<unsigned int>(receive<std::string>());
-    send(stepOutGroupSignaturesManager.getSignature(signatureIndex));
+    unsigned int signatureIndex;
+    request >> signatureIndex;
+    Payload signature = stepOutGroupSignaturesManager.getSignature(signatureIndex);
     std::cout << "GetSignatureCommand::execute() finished" << std::endl;
+    return signature;
 }
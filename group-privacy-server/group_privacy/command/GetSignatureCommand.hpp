@@ -34,8 +34,8 @@
 class GetSignatureCommand : public ICommand
 {
 public:
-    GetSignatureCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
-    void execute();
+    GetSignatureCommand();
+    Payload execute(Utils::Reader& request) const;
 private:
     StepOutGroupSignaturesManager& stepOutGroupSignaturesManager; /**< Manager of step-out group signatures. */
 };
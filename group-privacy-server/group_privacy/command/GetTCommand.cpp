@@ -0,0 +1,48 @@
+/**
+ * @file GetTCommand.cpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ */
+
+#include "GetTCommand.hpp"
+
+#include "../mpi/BigInteger.hpp"
+
+#include <iostream>
+
+GetTCommand::GetTCommand()
+    : stepOutGroupSignaturesManager(StepOutGroupSignaturesManager::instance())
+{
+}
+
+ICommand::Payload GetTCommand::execute(Utils::Reader& request) const
+{
+    std::cout << "GetTCommand::execute() started" << std::endl;
+    Utils::Writer response(stepOutGroupSignaturesManager.getElementWidth());
+    unsigned int signatureIndex;
+    request >> signatureIndex;
+    response << stepOutGroupSignaturesManager.getTFromPendingSignature(signatureIndex);
+    std::cout << "GetTCommand::execute() finished" << std::endl;
+    return share(response);
+}
@@ -29,55 +29,37 @@
 #define	ICOMMAND_HPP
 
 #include "SerializationUtils.hpp"
-#include "SocketManager.hpp"
 
-#include <boost/asio.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <string>
+
+/**
+ * ICommand class.
+ *
+ * Handles one kind of request. A command reads the request's
+ * arguments and returns the response's serialized values; it doesn't
+ * touch the connection, so requests of one session can be executed
+ * by many threads at the same time. An exception thrown by
+ * a command is sent back to the client as an error response.
+ *
+ * Values are returned in a shared buffer, so a command may return
+ * values serialized in advance and they are sent without copying.
+ */
 class ICommand
 {
 public:
-    ICommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
+    typedef boost::shared_ptr<const std::string> Payload;
+
     virtual ~ICommand() {}
-    virtual void execute() = 0;
+    virtual Payload execute(Utils::Reader& request) const = 0;
 protected:
-    template<typename Serializable>
-    Serializable receive();
-    template<typename Serializable>
-    void send(const Serializable& serializable);
-private:
-    SocketManager socketManager; /**< Manager used to send and receive data. */
+    static Payload share(const Utils::Writer& response);
 };
 
-inline ICommand::ICommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : socketManager(socket)
-{
-}
-
-template<typename Serializable>
-Serializable ICommand::receive()
-{
-    std::string serialized = socketManager.receive();
-    return Utils::deserialize<Serializable>(serialized);
-}
-
-template<>
-inline std::string ICommand::receive<std::string>()
-{
-    return socketManager.receive();
-}
-
-template<typename Serializable>
-void ICommand::send(const Serializable& serializable)
-{
-    std::string serialized = Utils::serialize(serializable);
-    socketManager.send(serialized);
-}
-
-template<>
-inline void ICommand::send<std::string>(const std::string& str)
+inline ICommand::Payload ICommand::share(const Utils::Writer& response)
 {
-    socketManager.send(str);
+    return Payload(new std::string(response.str()));
 }
 
 #endif // ICOMMAND_HPP
@@ -29,22 +29,27 @@
 
 #include "../step_out_group_signatures/InitializeSignatureInput.hpp"
 
-#include <boost/lexical_cast.hpp>
-
 #include <iostream>
+#include <stdexcept>
 
-InitializeSignatureCommand::InitializeSignatureCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket),
-      stepOutGroupSignaturesManager(StepOutGroupSignaturesManager::instance())
+InitializeSignatureCommand::InitializeSignatureCommand(const bool digestOnly)
+    : stepOutGroupSignaturesManager(StepOutGroupSignaturesManager::instance()),
+      digestOnly(digestOnly)
 {
 }
 
-void InitializeSignatureCommand::execute()
+ICommand::Payload InitializeSignatureCommand::execute(Utils::Reader& request) const
 {
     std::cout << "InitializeSignatureCommand::execute() started" << std::endl;
-    send(std::string("ok"));
-    InitializeSignatureInput input = receive<InitializeSignatureInput>();
-    unsigned int signatureIndex = stepOutGroupSignaturesManager.initializeSignature(input);
-    send(boost::lexical_cast<std::string>(signatureIndex));
+    Utils::Writer response;
+    InitializeSignatureInput input;
+    request >> input;
+    if(digestOnly && !stepOutGroupSignaturesManager.isMessageDigest(input.getMessage()))
+    {
+        std::cerr << "Invalid message digest from user " << input.getUserIndex() << " rejected." << std::endl;
+        throw std::runtime_error("invalid message digest");
+    }
+    response << stepOutGroupSignaturesManager.initializeSignature(input);
     std::cout << "InitializeSignatureCommand::execute() finished" << std::endl;
+    return share(response);
 }
@@ -34,10 +34,11 @@
 class InitializeSignatureCommand : public ICommand
 {
 public:
-    InitializeSignatureCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
-    void execute();
+    InitializeSignatureCommand(const bool digestOnly = false);
+    Payload execute(Utils::Reader& request) const;
 private:
     StepOutGroupSignaturesManager& stepOutGroupSignaturesManager; /**< Manager of step-out group signatures. */
+    const bool digestOnly; /**< True if only a digest of a message is accepted. */
 };
 
 #endif // INITIALIZESIGNATURECOMMAND_HPP
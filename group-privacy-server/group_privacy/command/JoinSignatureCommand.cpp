@@ -29,23 +29,20 @@
 
 #include "../step_out_group_signatures/JoinSignatureInput.hpp"
 
-#include <boost/lexical_cast.hpp>
-
 #include <iostream>
 
-JoinSignatureCommand::JoinSignatureCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket),
-      stepOutGroupSignaturesManager(StepOutGroupSignaturesManager::instance())
+JoinSignatureCommand::JoinSignatureCommand()
+    : stepOutGroupSignaturesManager(StepOutGroupSignaturesManager::instance())
 {
 }
 
-void JoinSignatureCommand::execute()
+ICommand::Payload JoinSignatureCommand::execute(Utils::Reader& request) const
 {
     std::cout << "JoinSignatureCommand::execute() started" << std::endl;
-    send(std::string("ok"));
-    unsigned int signatureIndex = boost::lexical_cast<unsigned int>(receive<std::string>());
-    send(stepOutGroupSignaturesManager.getTFromPendingSignature(signatureIndex));
-    JoinSignatureInput input = receive<JoinSignatureInput>();
+    unsigned int signatureIndex;
+    JoinSignatureInput input;
+    request >> signatureIndex >> input;
     stepOutGroupSignaturesManager.joinSignature(signatureIndex, input);
     std::cout << "JoinSignatureCommand::execute() finished" << std::endl;
+    return Payload();
 }
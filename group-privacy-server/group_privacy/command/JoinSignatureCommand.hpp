@@ -34,8 +34,8 @@
 class JoinSignatureCommand : public ICommand
 {
 public:
-    JoinSignatureCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
-    void execute();
+    JoinSignatureCommand();
+    Payload execute(Utils::Reader& request) const;
 private:
     StepOutGroupSignaturesManager& stepOutGroupSignaturesManager; /**< Manager of step-out group signatures. */
 };
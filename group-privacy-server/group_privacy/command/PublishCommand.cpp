@@ -30,19 +30,23 @@
 #include "../step_out_group_signatures/PublishProcedureInput.hpp"
 #include "SerializationUtils.hpp"
 
-PublishCommand::PublishCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket),
-      stepOutGroupSignaturesManager(StepOutGroupSignaturesManager::instance())
+PublishCommand::PublishCommand()
+    : stepOutGroupSignaturesManager(StepOutGroupSignaturesManager::instance())
 {
 }
 
-void PublishCommand::execute()
+ICommand::Payload PublishCommand::execute(Utils::Reader& request) const
 {
     std::cout << "PublishCommand::execute() started" << std::endl;
-    send(std::string("ok"));
-    PublishProcedureInput input = receive<PublishProcedureInput>();
-    stepOutGroupSignaturesManager.publish(input);
+    Utils::Writer response;
+    PublishProcedureInput input;
+    request >> input;
+    const bool accepted = stepOutGroupSignaturesManager.publish(input);
+    if(!accepted)
+        std::cerr << "Published values of user " << input.getUserIndex() << " rejected." << std::endl;
+    response << accepted;
     std::cout << "PublishCommand::execute() finished" << std::endl;
+    return share(response);
 
 //    std::cout << "PublishCommand::execute() started" << std::endl;
 //    socketManager.send("ok");
@@ -29,13 +29,9 @@
 
 #include <iostream>
 
-QuitCommand::QuitCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket)
-{
-}
-
-void QuitCommand::execute()
+ICommand::Payload QuitCommand::execute(Utils::Reader&) const
 {
     std::cout << "QuitCommand::execute() started" << std::endl;
     std::cout << "QuitCommand::execute() finished" << std::endl;
+    return Payload();
 }
@@ -33,8 +33,7 @@
 class QuitCommand : public ICommand
 {
 public:
-    QuitCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
-    void execute();
+    Payload execute(Utils::Reader& request) const;
 };
 
 #endif // QUITCOMMAND_HPP
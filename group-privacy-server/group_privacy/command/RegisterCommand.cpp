@@ -33,27 +33,23 @@
 #include "../step_out_group_signatures/UserPublicKey.hpp"
 #include "SerializationUtils.hpp"
 
-#include <boost/lexical_cast.hpp>
-
 #include <cstddef>
 
-RegisterCommand::RegisterCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket),
-      stepOutGroupSignaturesManager(StepOutGroupSignaturesManager::instance())
+RegisterCommand::RegisterCommand()
+    : stepOutGroupSignaturesManager(StepOutGroupSignaturesManager::instance())
 {
 }
 
-void RegisterCommand::execute()
+ICommand::Payload RegisterCommand::execute(Utils::Reader& request) const
 {
     std::cout << "RegisterCommand::execute() started" << std::endl;
-    send(stepOutGroupSignaturesManager.getGroupZpValues());
-    receive<std::string>(); // OK status
-    send(stepOutGroupSignaturesManager.getServerPublicKey());
-    Polynomial<SGS::X_POLYNOMIAL_DEGREE> x = receive<Polynomial<SGS::X_POLYNOMIAL_DEGREE> >();
-    send(stepOutGroupSignaturesManager.calculatePQPolynomials(x));
-    UserPublicKey userPublicKey = receive<UserPublicKey>();
-    send(boost::lexical_cast<std::string>(stepOutGroupSignaturesManager.registerNewUser(userPublicKey)));
+    Utils::Writer response;
+    UserPublicKey userPublicKey;
+    request >> userPublicKey;
+    const unsigned int userIndex = stepOutGroupSignaturesManager.registerNewUser(userPublicKey);
+    response << userIndex;
     std::cout << "RegisterCommand::execute() finished" << std::endl;
+    return share(response);
 
 //    std::cout << "RegisterCommand::execute() started" << std::endl;
 //    const GroupZpValues& groupZpValues = stepOutGroupSignaturesManager.getGroupZpValues();
@@ -31,8 +31,6 @@
 #include "../step_out_group_signatures/StepOutGroupSignaturesManager.hpp"
 #include "ICommand.hpp"
 
-#include <boost/asio.hpp>
-#include <boost/shared_ptr.hpp>
 
 class RegisterCommand : public ICommand
 {
@@ -42,12 +40,12 @@ public:
      *
      * @param socketInit socket Socket on which the client is connected.
      */
-    RegisterCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
+    RegisterCommand();
 
     /**
      * Implements the behavior of the "register" command.
      */
-    void execute();
+    Payload execute(Utils::Reader& request) const;
 private:
     StepOutGroupSignaturesManager& stepOutGroupSignaturesManager; /**< Manager of step-out group signatures. */
 };
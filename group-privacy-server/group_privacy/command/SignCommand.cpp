@@ -31,19 +31,20 @@
 #include "../step_out_group_signatures/SignProcedureOutput.hpp"
 #include "SerializationUtils.hpp"
 
-SignCommand::SignCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket)
-    : ICommand(socket),
-      stepOutGroupSignaturesManager(StepOutGroupSignaturesManager::instance())
+SignCommand::SignCommand()
+    : stepOutGroupSignaturesManager(StepOutGroupSignaturesManager::instance())
 {
 }
 
-void SignCommand::execute()
+ICommand::Payload SignCommand::execute(Utils::Reader& request) const
 {
     std::cout << "SignCommand::execute() started" << std::endl;
-    send(std::string("ok"));
-    SignProcedureInput input = receive<SignProcedureInput>();
-    send(stepOutGroupSignaturesManager.sign(input));
+    Utils::Writer response(stepOutGroupSignaturesManager.getElementWidth());
+    SignProcedureInput input;
+    request >> input;
+    response << stepOutGroupSignaturesManager.sign(input);
     std::cout << "SignCommand::execute() finished" << std::endl;
+    return share(response);
 
 //    std::cout << "SignCommand::execute() started" << std::endl;
 //    socketManager.send("ok");
@@ -31,14 +31,12 @@
 #include "../step_out_group_signatures/StepOutGroupSignaturesManager.hpp"
 #include "ICommand.hpp"
 
-#include <boost/asio.hpp>
-#include <boost/shared_ptr.hpp>
 
 class SignCommand : public ICommand
 {
 public:
-    SignCommand(boost::shared_ptr<boost::asio::ip::tcp::socket> socket);
-    void execute();
+    SignCommand();
+    Payload execute(Utils::Reader& request) const;
 private:
     StepOutGroupSignaturesManager&   stepOutGroupSignaturesManager;   /**< Manager of step-out group signatures. */
 };
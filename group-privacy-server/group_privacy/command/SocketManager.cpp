@@ -27,26 +27,73 @@
 
 #include "SocketManager.hpp"
 
-#include <boost/assert.hpp>
+#include <boost/lexical_cast.hpp>
 
-const std::size_t SocketManager::DATA_SIZE = 65536;
+#include <algorithm>
+#include <stdexcept>
 
-SocketManager::SocketManager(boost::shared_ptr<boost::asio::ip::tcp::socket> socketInit)
-    : socket(socketInit)
+const std::size_t SocketManager::HEADER_SIZE;
+const std::size_t SocketManager::CHUNK_SIZE;
+
+SocketManager::SocketManager(boost::shared_ptr<Socket> socketInit, const boost::uint64_t maxFrameSizeInit)
+    : socket(socketInit),
+      maxFrameSize(maxFrameSizeInit)
+{
+}
+
+std::string SocketManager::receive(boost::asio::yield_context yield)
+{
+    const boost::uint64_t length = receiveHeader(yield);
+    if(length > maxFrameSize)
+        throw std::runtime_error("Frame of " + boost::lexical_cast<std::string>(length) + " bytes is too big!");
+    const std::size_t size = static_cast<std::size_t>(length);
+    std::string frame;
+    while(frame.size() < size)
+    {
+        fill(std::min(size - frame.size(), CHUNK_SIZE), yield);
+        const std::size_t received = std::min(size - frame.size(), input.size());
+        frame.append(boost::asio::buffer_cast<const char*>(input.data()), received);
+        input.consume(received);
+    }
+    return frame;
+}
+
+void SocketManager::send(const std::string& data, boost::asio::yield_context yield)
+{
+    Header header;
+    encodeHeader(data.size(), header);
+    boost::array<boost::asio::const_buffer, 2> frame = {{
+        boost::asio::buffer(header),
+        boost::asio::buffer(data)
+    }};
+    boost::asio::async_write(*socket, frame, yield);
+}
+
+boost::uint64_t SocketManager::decodeHeader(const Header& header)
+{
+    boost::uint64_t length = 0;
+    for(std::size_t i = 0; i < HEADER_SIZE; ++i)
+        length = (length << 8) | header[i];
+    return length;
+}
+
+void SocketManager::encodeHeader(const boost::uint64_t length, Header& header)
 {
+    for(std::size_t i = 0; i < HEADER_SIZE; ++i)
+        header[i] = static_cast<unsigned char>(length >> (8 * (HEADER_SIZE - 1 - i)));
 }
 
-std::string SocketManager::receive()
+void SocketManager::fill(const std::size_t size, boost::asio::yield_context yield)
 {
-    boost::array<char, DATA_SIZE> buffer;
-    boost::system::error_code error;
-    std::size_t length = socket->read_some(boost::asio::buffer(buffer), error);
-    BOOST_ASSERT(length < DATA_SIZE);
-    return std::string(buffer.c_array(), length);
+    if(input.size() < size)
+        boost::asio::async_read(*socket, input, boost::asio::transfer_at_least(size - input.size()), yield);
 }
 
-void SocketManager::send(const std::string& data)
+boost::uint64_t SocketManager::receiveHeader(boost::asio::yield_context yield)
 {
-    BOOST_ASSERT(data.size() < DATA_SIZE);
-    socket->write_some(boost::asio::buffer(data));
+    Header header;
+    fill(HEADER_SIZE, yield);
+    boost::asio::buffer_copy(boost::asio::buffer(header), input.data());
+    input.consume(HEADER_SIZE);
+    return decodeHeader(header);
 }
@@ -28,22 +28,103 @@
 #ifndef SOCKETMANAGER_HPP
 #define	SOCKETMANAGER_HPP
 
+#include <boost/array.hpp>
 #include <boost/asio.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include <cstring>
 #include <string>
+#include <vector>
 
+/**
+ * SocketManager class.
+ *
+ * Sends and receives frames. Every frame starts with a header
+ * containing the payload's length as a 64-bit big-endian number.
+ * Frames are read and written whole, no matter how the stream
+ * splits them into segments. The socket may be of any stream
+ * protocol, so the same frames are exchanged over TCP and over
+ * local (AF_UNIX) connections.
+ *
+ * All operations are asynchronous and suspend the calling
+ * coroutine until they complete, so no thread waits for a client.
+ *
+ * Received data is buffered, so headers and small frames which
+ * a client has pipelined are taken from one read instead of two
+ * reads per frame. A frame's body is read in chunks of bounded size,
+ * so memory is allocated only for bytes which have really arrived,
+ * and frames longer than the given limit are refused as soon as
+ * their headers are read. Many frames may be sent with one write as well.
+ *
+ * Every frame is kept whole in memory. Payloads are not streamed;
+ * clients sign big messages in digest mode, so only their digests
+ * are sent.
+ */
 class SocketManager : private boost::noncopyable
 {
 public:
-    SocketManager(boost::shared_ptr<boost::asio::ip::tcp::socket> socketInit);
-    std::string receive();
-    void send(const std::string& data);
+    typedef boost::asio::generic::stream_protocol::socket Socket;
+
+    SocketManager(boost::shared_ptr<Socket> socketInit, const boost::uint64_t maxFrameSizeInit);
+    std::string receive(boost::asio::yield_context yield);
+    void send(const std::string& data, boost::asio::yield_context yield);
+
+    /**
+     * Sends a frame gathered from a sequence of buffers,
+     * without copying them into one buffer.
+     */
+    template<typename ConstBufferSequence>
+    void send(const ConstBufferSequence& buffers, boost::asio::yield_context yield);
+
+    /**
+     * Sends many frames with one write. Every element
+     * of the given vector holds buffers of one frame.
+     */
+    template<typename ConstBufferSequence>
+    void send(const std::vector<ConstBufferSequence>& frames, boost::asio::yield_context yield);
 private:
-    static const std::size_t                          DATA_SIZE;   /**< Maximal size of sending and receiving data. */
-    boost::shared_ptr<boost::asio::ip::tcp::socket>   socket;      /**< Socket used to send and receive data. */
+    static const std::size_t       HEADER_SIZE = 8;       /**< Size of a frame's header. */
+    static const std::size_t       CHUNK_SIZE = 65536;    /**< Maximal number of bytes read at once into a frame. */
+
+    typedef boost::array<unsigned char, HEADER_SIZE> Header;
+
+    static boost::uint64_t decodeHeader(const Header& header);
+    static void encodeHeader(const boost::uint64_t length, Header& header);
+    void fill(const std::size_t size, boost::asio::yield_context yield);
+    boost::uint64_t receiveHeader(boost::asio::yield_context yield);
+
+    boost::shared_ptr<Socket>                         socket;   /**< Socket used to send and receive data. */
+    const boost::uint64_t                             maxFrameSize; /**< Maximal size of a received frame. */
+    boost::asio::streambuf                            input;    /**< Data received but not consumed yet. */
 };
 
+template<typename ConstBufferSequence>
+void SocketManager::send(const ConstBufferSequence& buffers, boost::asio::yield_context yield)
+{
+    Header header;
+    encodeHeader(boost::asio::buffer_size(buffers), header);
+    std::vector<boost::asio::const_buffer> frame(1, boost::asio::buffer(header));
+    frame.insert(frame.end(), boost::asio::buffer_sequence_begin(buffers), boost::asio::buffer_sequence_end(buffers));
+    boost::asio::async_write(*socket, frame, yield);
+}
+
+template<typename ConstBufferSequence>
+void SocketManager::send(const std::vector<ConstBufferSequence>& frames, boost::asio::yield_context yield)
+{
+    std::vector<Header> headers(frames.size());
+    std::vector<boost::asio::const_buffer> buffers;
+    for(std::size_t i = 0; i < frames.size(); ++i)
+    {
+        encodeHeader(boost::asio::buffer_size(frames[i]), headers[i]);
+        buffers.push_back(boost::asio::buffer(headers[i]));
+        buffers.insert(buffers.end(),
+                       boost::asio::buffer_sequence_begin(frames[i]),
+                       boost::asio::buffer_sequence_end(frames[i]));
+    }
+    boost::asio::async_write(*socket, buffers, yield);
+}
+
 #endif // SOCKETMANAGER_HPP
@@ -0,0 +1,216 @@
+/**
+ * @file SegmentedTable.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains SegmentedTable class template which is
+ * an append-only table safe to read and grow concurrently.
+ */
+
+#ifndef SEGMENTEDTABLE_HPP
+#define	SEGMENTEDTABLE_HPP
+
+#include <boost/assert.hpp>
+#include <boost/atomic.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <cstddef>
+#include <new>
+
+/**
+ * SegmentedTable class template.
+ *
+ * Append-only table of elements of type \c T. Elements are stored
+ * in segments of doubling sizes which are never reallocated, so
+ * references to the elements stay valid for the lifetime of the table.
+ * Appending and reading are lock-free: a slot is reserved with an atomic
+ * counter, the element is constructed in place and then published.
+ */
+template<typename T>
+class SegmentedTable : private boost::noncopyable
+{
+public:
+    SegmentedTable();
+    ~SegmentedTable();
+
+    /**
+     * Appends a copy of a given element.
+     *
+     * @param element Element to append.
+     *
+     * @return Index number assigned to the element.
+     */
+    std::size_t append(const T& element);
+
+    /**
+     * Checks whether an element of a given index has been published.
+     *
+     * @param index Index number of the element.
+     *
+     * @return True if the element exists. False otherwise.
+     */
+    bool contains(const std::size_t index) const;
+
+    T& operator[](const std::size_t index);
+    const T& operator[](const std::size_t index) const;
+
+    /**
+     * Returns the number of reserved slots. Some of them may
+     * still be under construction, see \c contains().
+     *
+     * @return Number of reserved slots.
+     */
+    std::size_t size() const;
+private:
+    struct Slot
+    {
+        Slot() : published(false) {}
+        boost::aligned_storage<sizeof(T), boost::alignment_of<T>::value>   storage;
+        boost::atomic<bool>                                                 published;
+    };
+
+    static const std::size_t   FIRST_SEGMENT_BITS   = 6;    /**< The first segment holds 2^6 elements. */
+    static const std::size_t   NUMBER_OF_SEGMENTS   = 26;   /**< Enough for 2^32 elements. */
+
+    static std::size_t segmentOf(const std::size_t index);
+    static std::size_t segmentSize(const std::size_t segment);
+    static std::size_t offsetOf(const std::size_t index, const std::size_t segment);
+    Slot& slot(const std::size_t index) const;
+    Slot* acquireSegment(const std::size_t segment);
+
+    boost::atomic<Slot*>         segments[NUMBER_OF_SEGMENTS];   /**< Lazily allocated segments. */
+    boost::atomic<std::size_t>   reserved;                       /**< Number of reserved slots. */
+};
+
+template<typename T>
+SegmentedTable<T>::SegmentedTable() : reserved(0)
+{
+    for(std::size_t i = 0; i < NUMBER_OF_SEGMENTS; ++i)
+        segments[i].store(0, boost::memory_order_relaxed);
+}
+
+template<typename T>
+SegmentedTable<T>::~SegmentedTable()
+{
+    for(std::size_t i = 0; i < NUMBER_OF_SEGMENTS; ++i)
+    {
+        Slot* segment = segments[i].load(boost::memory_order_acquire);
+        if(!segment)
+            continue;
+        for(std::size_t j = 0; j < segmentSize(i); ++j)
+        {
+            if(segment[j].published.load(boost::memory_order_acquire))
+                reinterpret_cast<T*>(segment[j].storage.address())->~T();
+        }
+        delete[] segment;
+    }
+}
+
+template<typename T>
+std::size_t SegmentedTable<T>::append(const T& element)
+{
+    const std::size_t index = reserved.fetch_add(1, boost::memory_order_relaxed);
+    const std::size_t segment = segmentOf(index);
+    BOOST_ASSERT(segment < NUMBER_OF_SEGMENTS);
+    Slot& newSlot = acquireSegment(segment)[offsetOf(index, segment)];
+    new (newSlot.storage.address()) T(element);
+    newSlot.published.store(true, boost::memory_order_release);
+    return index;
+}
+
+template<typename T>
+bool SegmentedTable<T>::contains(const std::size_t index) const
+{
+    if(index >= reserved.load(boost::memory_order_acquire))
+        return false;
+    const std::size_t segment = segmentOf(index);
+    Slot* slots = segments[segment].load(boost::memory_order_acquire);
+    return (slots && slots[offsetOf(index, segment)].published.load(boost::memory_order_acquire));
+}
+
+template<typename T>
+T& SegmentedTable<T>::operator[](const std::size_t index)
+{
+    BOOST_ASSERT(contains(index));
+    return *reinterpret_cast<T*>(slot(index).storage.address());
+}
+
+template<typename T>
+const T& SegmentedTable<T>::operator[](const std::size_t index) const
+{
+    BOOST_ASSERT(contains(index));
+    return *reinterpret_cast<const T*>(slot(index).storage.address());
+}
+
+template<typename T>
+std::size_t SegmentedTable<T>::size() const
+{
+    return reserved.load(boost::memory_order_acquire);
+}
+
+template<typename T>
+std::size_t SegmentedTable<T>::segmentOf(const std::size_t index)
+{
+    std::size_t shifted = (index >> FIRST_SEGMENT_BITS) + 1;
+    std::size_t segment = 0;
+    while(shifted >>= 1)
+        ++segment;
+    return segment;
+}
+
+template<typename T>
+std::size_t SegmentedTable<T>::segmentSize(const std::size_t segment)
+{
+    return (std::size_t(1) << (FIRST_SEGMENT_BITS + segment));
+}
+
+template<typename T>
+std::size_t SegmentedTable<T>::offsetOf(const std::size_t index, const std::size_t segment)
+{
+    return index + (std::size_t(1) << FIRST_SEGMENT_BITS) - segmentSize(segment);
+}
+
+template<typename T>
+typename SegmentedTable<T>::Slot& SegmentedTable<T>::slot(const std::size_t index) const
+{
+    const std::size_t segment = segmentOf(index);
+    return segments[segment].load(boost::memory_order_acquire)[offsetOf(index, segment)];
+}
+
+template<typename T>
+typename SegmentedTable<T>::Slot* SegmentedTable<T>::acquireSegment(const std::size_t segment)
+{
+    Slot* slots = segments[segment].load(boost::memory_order_acquire);
+    if(slots)
+        return slots;
+    Slot* allocated = new Slot[segmentSize(segment)];
+    if(segments[segment].compare_exchange_strong(slots, allocated, boost::memory_order_acq_rel))
+        return allocated;
+    delete[] allocated; // another thread has installed the segment first
+    return slots;
+}
+
+#endif // SEGMENTEDTABLE_HPP
@@ -27,37 +27,143 @@
 
 #include "GroupPrivacyServerManager.hpp"
 
+#include "../step_out_group_signatures/StepOutGroupSignaturesManager.hpp"
+
 #include <boost/bind.hpp>
-#include <boost/thread.hpp>
 
-GroupPrivacyServerManager::GroupPrivacyServerManager(boost::asio::io_service& p_service, const int p_port)
-    : m_acceptor(p_service, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), p_port)),
-      m_service(p_service)
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+const long GroupPrivacyServerManager::ACCEPT_RETRY_DELAY;
+
+GroupPrivacyServerManager::Listener::Listener(boost::asio::io_service& p_service,
+                                              const Acceptor::endpoint_type& p_endpoint)
+    : acceptor(p_service, p_endpoint),
+      retryTimer(p_service),
+      accepting(false)
 {
-    prepareNewSession();
 }
 
-void GroupPrivacyServerManager::prepareNewSession()
+GroupPrivacyServerManager::GroupPrivacyServerManager(
+    boost::asio::io_service& p_service,
+    const int p_port,
+    const std::string& p_localPath,
+    const SessionLimits& p_limits)
+    : m_service(p_service),
+      m_limits(p_limits),
+      m_queuedRequests(0),
+      m_sessions(0)
 {
-    boost::shared_ptr<Session> l_newSession(new Session(m_service));
-    m_acceptor.async_accept(*l_newSession->getSocket(),
-                            boost::bind(&GroupPrivacyServerManager::handleConnection,
-                                        this,
-                                        l_newSession,
-                                        boost::asio::placeholders::error));
+    StepOutGroupSignaturesManager::instance().setSignatureTimeout(m_limits.requestTimeout);
+    boost::asio::ip::tcp::endpoint l_tcpEndpoint(boost::asio::ip::tcp::v4(), p_port);
+    m_listeners.push_back(boost::shared_ptr<Listener>(new Listener(m_service, l_tcpEndpoint)));
+    if(!p_localPath.empty())
+    {
+        removeStaleSocket(p_localPath);
+        boost::asio::local::stream_protocol::endpoint l_localEndpoint(p_localPath);
+        m_listeners.push_back(boost::shared_ptr<Listener>(new Listener(m_service, l_localEndpoint)));
+    }
+    boost::mutex::scoped_lock l_lock(m_mutex);
+    for(std::size_t i = 0; i < m_listeners.size(); ++i)
+        prepareNewSession(m_listeners[i]);
 }
 
-void GroupPrivacyServerManager::handleConnection(boost::shared_ptr<Session> p_session,
+void GroupPrivacyServerManager::prepareNewSession(boost::shared_ptr<Listener> p_listener)
+{
+    boost::shared_ptr<Session> l_newSession(new Session(m_service, m_limits, m_queuedRequests));
+    p_listener->accepting = true;
+    p_listener->acceptor.async_accept(*l_newSession->getSocket(),
+                                      boost::bind(&GroupPrivacyServerManager::handleConnection,
+                                                  this,
+                                                  p_listener,
+                                                  l_newSession,
+                                                  boost::asio::placeholders::error));
+}
+
+void GroupPrivacyServerManager::handleConnection(boost::shared_ptr<Listener> p_listener,
+                                                 boost::shared_ptr<Session> p_session,
                                                  const boost::system::error_code& p_error)
 {
-    if(!p_error)
+    if(p_error)
+    {
+        boost::mutex::scoped_lock l_lock(m_mutex);
+        p_listener->accepting = false;
+        if(p_error != boost::asio::error::operation_aborted)
+        {
+            std::cerr << "Accepting a connection failed: " << p_error.message() << std::endl;
+            if(isOutOfResources(p_error) && p_listener->acceptor.is_open())
+            {
+                p_listener->accepting = true;
+                p_listener->retryTimer.expires_from_now(boost::posix_time::milliseconds(ACCEPT_RETRY_DELAY));
+                p_listener->retryTimer.async_wait(boost::bind(&GroupPrivacyServerManager::handleRetry,
+                                                              this,
+                                                              p_listener,
+                                                              boost::asio::placeholders::error));
+                return;
+            }
+        }
+        if(m_sessions < m_limits.maxSessions && p_listener->acceptor.is_open())
+            prepareNewSession(p_listener);
+        return;
+    }
     {
-        createSessionThread(p_session);
-        prepareNewSession();
+        boost::mutex::scoped_lock l_lock(m_mutex);
+        p_listener->accepting = false;
+        if(++m_sessions < m_limits.maxSessions)
+            prepareNewSession(p_listener);
+        else
+            for(std::size_t i = 0; i < m_listeners.size(); ++i)
+                if(m_listeners[i]->accepting)
+                {
+                    m_listeners[i]->acceptor.cancel();
+                    m_listeners[i]->retryTimer.cancel();
+                }
     }
+    p_session->start(boost::bind(&GroupPrivacyServerManager::handleSessionFinished, this));
 }
 
-void GroupPrivacyServerManager::createSessionThread(boost::shared_ptr<Session> p_session)
+void GroupPrivacyServerManager::handleRetry(boost::shared_ptr<Listener> p_listener,
+                                            const boost::system::error_code&)
 {
-    boost::thread l_sessionThread(*p_session);
+    boost::mutex::scoped_lock l_lock(m_mutex);
+    p_listener->accepting = false;
+    if(m_sessions < m_limits.maxSessions && p_listener->acceptor.is_open())
+        prepareNewSession(p_listener);
+}
+
+void GroupPrivacyServerManager::handleSessionFinished()
+{
+    boost::mutex::scoped_lock l_lock(m_mutex);
+    --m_sessions;
+    for(std::size_t i = 0; i < m_listeners.size(); ++i)
+        if(!m_listeners[i]->accepting && m_listeners[i]->acceptor.is_open())
+            prepareNewSession(m_listeners[i]);
+}
+
+bool GroupPrivacyServerManager::isOutOfResources(const boost::system::error_code& p_error)
+{
+    return (p_error == boost::asio::error::no_descriptors
+            || p_error == boost::system::errc::too_many_files_open_in_system
+            || p_error == boost::asio::error::no_buffer_space
+            || p_error == boost::asio::error::no_memory);
+}
+
+void GroupPrivacyServerManager::removeStaleSocket(const std::string& p_path)
+{
+    struct stat l_status;
+    if(lstat(p_path.c_str(), &l_status) != 0)
+    {
+        if(errno == ENOENT)
+            return;
+        throw std::runtime_error(p_path + ": " + std::strerror(errno));
+    }
+    if(!S_ISSOCK(l_status.st_mode))
+        throw std::runtime_error(p_path + " exists and isn't a socket!");
+    if(unlink(p_path.c_str()) != 0 && errno != ENOENT)
+        throw std::runtime_error(p_path + ": " + std::strerror(errno));
 }
@@ -32,14 +32,35 @@
 #define	GROUPPRIVACYSERVERMANAGER_HPP
 
 #include "Session.hpp"
+#include "SessionLimits.hpp"
 
 #include <boost/asio.hpp>
+#include <boost/atomic.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
 
 /**
  * A GroupPrivacyServerManager class.
  * Handles new connections and manages clients' sessions.
+ *
+ * Sessions are served by threads running the service, so the number
+ * of connections doesn't depend on the number of threads. When the
+ * number of open sessions reaches its limit, the manager stops
+ * accepting connections until one of the sessions ends. Pending
+ * connections wait in the listen queue in the meantime.
+ *
+ * Clients connect over TCP or, if a path is given, over a local
+ * (AF_UNIX) stream socket. Co-located clients using the latter
+ * bypass the TCP stack. Sessions of both kinds are served alike.
+ *
+ * A failed accept doesn't stop a listener. If it has failed for lack
+ * of file descriptors or memory, accepting resumes after a short delay,
+ * so that the failure isn't repeated in a busy loop.
  */
 class GroupPrivacyServerManager : private boost::noncopyable
 {
@@ -52,33 +73,97 @@ public:
      *
      * @param p_service Service that provides data flow during a session.
      * @param p_port Connection port.
+     * @param p_localPath Path of a local socket to listen on. Empty if clients connect over TCP only.
+     *                    A stale socket existing at the path is replaced.
+     *                    Any other file there is kept and std::runtime_error is thrown.
+     * @param p_limits Limits of resources used by sessions.
      */
-    GroupPrivacyServerManager(boost::asio::io_service& p_service, const int p_port);
+    GroupPrivacyServerManager(boost::asio::io_service& p_service,
+                              const int p_port,
+                              const std::string& p_localPath,
+                              const SessionLimits& p_limits);
 private:
+    typedef boost::asio::basic_socket_acceptor<boost::asio::generic::stream_protocol> Acceptor;
+
+    /**
+     * Socket on which the server accepts connections.
+     */
+    struct Listener
+    {
+        Listener(boost::asio::io_service& p_service, const Acceptor::endpoint_type& p_endpoint);
+
+        Acceptor                      acceptor;     /**< Acceptor that enables new connections. */
+        boost::asio::deadline_timer   retryTimer;   /**< Delays accepting after a lack of resources. */
+        bool                          accepting;    /**< True if a connection is being accepted or will be after a delay. */
+    };
+
+    static const long   ACCEPT_RETRY_DELAY = 500;   /**< Milliseconds to wait before accepting again after a lack of resources. */
+
+    /**
+     * Checks whether accepting has failed for lack of resources,
+     * which may be available again soon.
+     *
+     * @param p_error Error identifier.
+     *
+     * @return True if there are no descriptors, buffers or memory left.
+     */
+    static bool isOutOfResources(const boost::system::error_code& p_error);
+
+    /**
+     * Removes a socket left at a given path by a previous run.
+     *
+     * @param p_path Path of the local socket.
+     *
+     * @throw std::runtime_error If a file other than a socket exists
+     *                           at the path or it can't be removed.
+     */
+    static void removeStaleSocket(const std::string& p_path);
+
     /**
-     * Prepares a new client's connection.
+     * Prepares a new client's connection on a given listener.
+     *
+     * @param p_listener Listener to accept the connection.
      */
-    void prepareNewSession();
+    void prepareNewSession(boost::shared_ptr<Listener> p_listener);
 
     /**
-     * Handles a client's connection to the server by invoking
-     * creation of a new thread for the given session.
-     * At the end triggers preparation of a new session.
+     * Handles a client's connection to the server by starting
+     * the given session. At the end triggers preparation of a new
+     * session unless the limit of open sessions is reached.
+     * When it is reached, connections pending on other listeners
+     * are cancelled. If accepting has failed, the error is logged
+     * and a new connection is accepted, after a delay if there
+     * was a lack of resources.
      *
+     * @param p_listener Listener which has accepted the connection.
      * @param p_session A session to start.
      * @param p_error Error identifier. Should be 0 if there were no errors.
      */
-    void handleConnection(boost::shared_ptr<Session> p_session, const boost::system::error_code& p_error);
+    void handleConnection(boost::shared_ptr<Listener> p_listener,
+                          boost::shared_ptr<Session> p_session,
+                          const boost::system::error_code& p_error);
 
     /**
-     * Creates a new thread for the given client's session.
+     * Handles the end of a delay after a lack of resources by preparing
+     * a new session, unless the limit of open sessions has been reached.
      *
-     * @param p_session Client's session.
+     * @param p_listener Listener to accept the connection.
+     * @param p_error Error identifier. Should be 0 if the delay wasn't cancelled.
+     */
+    void handleRetry(boost::shared_ptr<Listener> p_listener, const boost::system::error_code& p_error);
+
+    /**
+     * Handles the end of a session. Resumes accepting
+     * new connections on listeners which have stopped.
      */
-    void createSessionThread(boost::shared_ptr<Session> p_session);
+    void handleSessionFinished();
 
-    boost::asio::ip::tcp::acceptor   m_acceptor;   /**< Acceptor that enables new connections. */
-    boost::asio::io_service&         m_service;    /**< Service needed to create sockets. */
+    boost::asio::io_service&                        m_service;          /**< Service needed to create sockets. */
+    const SessionLimits                             m_limits;           /**< Limits of resources used by sessions. */
+    boost::atomic<std::size_t>                      m_queuedRequests;   /**< Number of requests of all sessions waiting for execution. */
+    boost::mutex                                    m_mutex;            /**< Guards the fields below. */
+    std::vector<boost::shared_ptr<Listener> >       m_listeners;        /**< Sockets on which connections are accepted. */
+    std::size_t                                     m_sessions;         /**< Number of open sessions. */
 };
 
 #endif // GROUPPRIVACYSERVERMANAGER_HPP
@@ -29,78 +29,209 @@
 
 #include "Session.hpp"
 
-#include "../command/Commands.hpp"
+#include "../command/CommandTable.hpp"
 
-#include <boost/array.hpp>
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
 
-Session::Session(boost::asio::io_service& p_service)
-    : m_socket(new boost::asio::ip::tcp::socket(p_service))
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+const std::size_t Session::MAX_BATCHED_RESPONSES;
+const std::string Session::BUSY_MESSAGE = "Server is busy, try again later.";
+
+Session::Session(boost::asio::io_service& p_service,
+                 const SessionLimits& p_limits,
+                 boost::atomic<std::size_t>& p_queuedRequests)
+    : m_service(p_service),
+      m_limits(p_limits),
+      m_queuedRequests(p_queuedRequests),
+      m_strand(p_service.get_executor()),
+      m_socket(new SocketManager::Socket(p_service)),
+      m_socketManager(new SocketManager(m_socket, p_limits.maxRequestSize)),
+      m_pendingRequests(0),
+      m_idleTimer(p_service),
+      m_writeTimer(p_service)
 {
-    registerCommands();
 }
 
-Session::Session(const Session& p_session)
+Session::~Session()
 {
-    m_socket = p_session.m_socket;
-    registerCommands();
+    if(m_finishHandler)
+        m_finishHandler();
 }
 
-Session& Session::operator=(const Session& p_session)
+boost::shared_ptr<SocketManager::Socket> Session::getSocket()
 {
-    m_socket = p_session.m_socket;
-    commands = p_session.commands;
-    return *this;
+    return m_socket;
 }
 
-boost::shared_ptr<boost::asio::ip::tcp::socket> Session::getSocket()
+void Session::start(const FinishHandler& p_finishHandler)
 {
-    return m_socket;
+    m_finishHandler = p_finishHandler;
+    boost::asio::spawn(m_strand,
+                       boost::bind(&Session::run, shared_from_this(), _1),
+                       boost::coroutines::attributes(STACK_SIZE));
+}
+
+bool Session::admitRequest()
+{
+    if(++m_queuedRequests > m_limits.maxQueuedRequests)
+    {
+        --m_queuedRequests;
+        return false;
+    }
+    if(++m_pendingRequests > m_limits.maxSessionRequests)
+    {
+        --m_pendingRequests;
+        --m_queuedRequests;
+        return false;
+    }
+    return true;
 }
 
-void Session::operator()()
+Session::Response Session::createErrorResponse(const unsigned int p_requestId, const std::string& p_message)
 {
-    run();
+    Response response;
+    response.header = Envelope::encodeResponseHeader(p_requestId, false);
+    response.values.reset(new std::string(p_message));
+    return response;
 }
 
-void Session::registerCommands()
+boost::posix_time::ptime Session::createDeadline(const long p_seconds)
 {
-    commands["check"].reset(new CheckCommand(m_socket));
-    commands["close-signature"].reset(new CloseSignatureCommand(m_socket));
-    commands["finalize-signature"].reset(new FinalizeSignatureCommand(m_socket));
-    commands["get-signature"].reset(new GetSignatureCommand(m_socket));
-    commands["initialize-signature"].reset(new InitializeSignatureCommand(m_socket));
-    commands["join-signature"].reset(new JoinSignatureCommand(m_socket));
-    commands["publish"].reset(new PublishCommand(m_socket));
-    commands["quit"].reset(new QuitCommand(m_socket));
-    commands["register"].reset(new RegisterCommand(m_socket));
-    commands["sign"].reset(new SignCommand(m_socket));
-    commands["verify"].reset(new VerifyCommand(m_socket));
+    if(p_seconds <= 0)
+        return boost::posix_time::ptime(boost::posix_time::pos_infin);
+    return boost::posix_time::microsec_clock::universal_time() + boost::posix_time::seconds(p_seconds);
 }
 
-void Session::run()
+Session::Response Session::executeRequest(const unsigned int p_requestId,
+                                          const unsigned int p_operation,
+                                          const std::string& p_arguments)
 {
     try
     {
-        std::string command;
-        while(command != "quit")
+        const ICommand* command = CommandTable::find(p_operation);
+        if(!command)
+            throw std::runtime_error("Unknown operation received: " + boost::lexical_cast<std::string>(p_operation));
+        Utils::Reader arguments(p_arguments);
+        Response response;
+        response.values = command->execute(arguments);
+        response.header = Envelope::encodeResponseHeader(p_requestId, true);
+        return response;
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return createErrorResponse(p_requestId, e.what());
+    }
+}
+
+void Session::executeQueuedRequest(const unsigned int p_requestId,
+                                   const unsigned int p_operation,
+                                   const std::string& p_arguments,
+                                   const boost::posix_time::ptime& p_deadline)
+{
+    const Response response = (boost::posix_time::microsec_clock::universal_time() > p_deadline
+                               ? createErrorResponse(p_requestId, BUSY_MESSAGE)
+                               : executeRequest(p_requestId, p_operation, p_arguments));
+    --m_pendingRequests;
+    --m_queuedRequests;
+    boost::asio::dispatch(m_strand, boost::bind(&Session::queueResponse, shared_from_this(), response));
+}
+
+void Session::handleTimeout(boost::asio::deadline_timer& p_timer, const boost::system::error_code& p_error)
+{
+    if(p_error || p_timer.expires_at() > boost::asio::deadline_timer::traits_type::now())
+        return;
+    std::cerr << "Closing the session of an unresponsive client." << std::endl;
+    boost::system::error_code l_error;
+    m_socket->close(l_error);
+}
+
+void Session::queueResponse(const Response& p_response)
+{
+    m_responses.push_back(p_response);
+    if(m_responses.size() == 1)
+        boost::asio::spawn(m_strand,
+                           boost::bind(&Session::writeResponses, shared_from_this(), _1),
+                           boost::coroutines::attributes(STACK_SIZE));
+}
+
+void Session::run(boost::asio::yield_context p_yield)
+{
+    try
+    {
+        unsigned int operation = Envelope::NUMBER_OF_OPERATIONS;
+        while(operation != Envelope::QUIT)
         {
-            command = receive();
-            if(commands.count(command))
-                commands[command]->execute();
+            unsigned int requestId;
+            std::string arguments;
+            startTimer(m_idleTimer, m_limits.idleTimeout);
+            Envelope::decodeRequest(m_socketManager->receive(p_yield), requestId, operation, arguments);
+            if(operation == Envelope::QUIT)
+                queueResponse(executeRequest(requestId, operation, arguments));
+            else if(!admitRequest())
+                queueResponse(createErrorResponse(requestId, BUSY_MESSAGE));
             else
-                std::cerr << "Wrong command received: " << command << std::endl;
+                m_service.post(boost::bind(&Session::executeQueuedRequest,
+                                           shared_from_this(),
+                                           requestId,
+                                           operation,
+                                           arguments,
+                                           createDeadline(m_limits.requestTimeout)));
         }
     }
+    catch(boost::system::system_error& e)
+    {
+        if(e.code() != boost::asio::error::eof && e.code() != boost::asio::error::operation_aborted)
+            std::cerr << e.what() << std::endl;
+    }
     catch(std::exception& e)
     {
         std::cerr << e.what() << std::endl;
     }
+    m_idleTimer.cancel();
 }
 
-std::string Session::receive()
+void Session::startTimer(boost::asio::deadline_timer& p_timer, const long p_seconds)
 {
-    boost::array<char, 512> l_array;
-    boost::system::error_code l_error;
-    std::size_t l_len = m_socket->read_some(boost::asio::buffer(l_array), l_error);
-    return std::string(l_array.c_array(), l_len);
+    if(p_seconds <= 0)
+        return;
+    p_timer.expires_from_now(boost::posix_time::seconds(p_seconds));
+    p_timer.async_wait(boost::asio::bind_executor(m_strand,
+                                                  boost::bind(&Session::handleTimeout,
+                                                              shared_from_this(),
+                                                              boost::ref(p_timer),
+                                                              boost::asio::placeholders::error)));
+}
+
+void Session::writeResponses(boost::asio::yield_context p_yield)
+{
+    try
+    {
+        std::vector<boost::array<boost::asio::const_buffer, 2> > frames;
+        while(!m_responses.empty())
+        {
+            const std::size_t count = std::min(m_responses.size(), MAX_BATCHED_RESPONSES);
+            frames.resize(count);
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                const Response& response = m_responses[i];
+                frames[i][0] = boost::asio::buffer(response.header);
+                frames[i][1] = response.values ? boost::asio::buffer(*response.values) : boost::asio::const_buffer();
+            }
+            startTimer(m_writeTimer, m_limits.writeTimeout);
+            m_socketManager->send(frames, p_yield);
+            m_responses.erase(m_responses.begin(), m_responses.begin() + count);
+        }
+    }
+    catch(boost::system::system_error& e)
+    {
+        m_responses.clear();
+        std::cerr << e.what() << std::endl;
+    }
+    m_writeTimer.cancel();
 }
@@ -30,34 +30,115 @@
 #ifndef SESSION_HPP
 #define	SESSION_HPP
 
+#include "../command/Envelope.hpp"
 #include "../command/ICommand.hpp"
+#include "../command/SocketManager.hpp"
+#include "SessionLimits.hpp"
 #include "../step_out_group_signatures/StepOutGroupSignaturesConstants.hpp"
 #include "../step_out_group_signatures/StepOutGroupSignaturesManager.hpp"
 
 #include <boost/asio.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/atomic.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/enable_shared_from_this.hpp>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include <cstring>
-#include <map>
+#include <deque>
 #include <memory>
 #include <string>
 
-class Session : public boost::enable_shared_from_this<Session>
+/**
+ * Session class.
+ *
+ * Manages one client's connection. A session doesn't own a thread.
+ * It runs in a coroutine which is suspended whenever it waits
+ * for the client, so any of the threads running the service
+ * can resume it.
+ *
+ * Every request carries an identifier chosen by the client and
+ * is answered with exactly one response carrying the same
+ * identifier. The session doesn't wait for a request to be
+ * executed before reading the next one, so a client may pipeline
+ * requests and their responses may come back in a different order.
+ * Reading, writing and the queue of responses are confined
+ * to the session's strand. Responses which are queued while
+ * a write is in progress are sent together with the next write.
+ *
+ * A session is closed when its client doesn't send a whole request
+ * or doesn't receive its responses in time. When too many requests
+ * of the session or of all sessions wait for execution, or a request
+ * has waited too long, the request is refused with a busy response.
+ */
+class Session : public boost::enable_shared_from_this<Session>, private boost::noncopyable
 {
 public:
-    Session(boost::asio::io_service& p_service);
-    Session(const Session& p_session);
-    Session& operator=(const Session& p_session);
-    boost::shared_ptr<boost::asio::ip::tcp::socket> getSocket();
-    void operator()();
+    typedef boost::function<void()> FinishHandler;
+
+    /**
+     * Constructor of the Session class.
+     *
+     * @param p_service Service executing the session's requests.
+     * @param p_limits Limits of resources used by the session.
+     * @param p_queuedRequests Number of requests of all sessions waiting for execution.
+     */
+    Session(boost::asio::io_service& p_service,
+            const SessionLimits& p_limits,
+            boost::atomic<std::size_t>& p_queuedRequests);
+    ~Session();
+    boost::shared_ptr<SocketManager::Socket> getSocket();
+
+    /**
+     * Starts serving the connected client.
+     *
+     * @param p_finishHandler Function called when the session ends.
+     */
+    void start(const FinishHandler& p_finishHandler);
 private:
-    void registerCommands();
-    void run();
-    std::string receive();
+    typedef boost::asio::strand<boost::asio::io_service::executor_type> Strand;
+
+    /**
+     * Response waiting to be sent. Its values are shared
+     * with the command which has created them.
+     */
+    struct Response
+    {
+        Envelope::ResponseHeader   header;   /**< Header of the response. */
+        ICommand::Payload          values;   /**< Serialized values or an error message. */
+    };
+
+    bool admitRequest();
+    static boost::posix_time::ptime createDeadline(const long p_seconds);
+    static Response createErrorResponse(const unsigned int p_requestId, const std::string& p_message);
+    Response executeRequest(const unsigned int p_requestId, const unsigned int p_operation, const std::string& p_arguments);
+    void executeQueuedRequest(const unsigned int p_requestId,
+                              const unsigned int p_operation,
+                              const std::string& p_arguments,
+                              const boost::posix_time::ptime& p_deadline);
+    void handleTimeout(boost::asio::deadline_timer& p_timer, const boost::system::error_code& p_error);
+    void queueResponse(const Response& p_response);
+    void run(boost::asio::yield_context p_yield);
+    void startTimer(boost::asio::deadline_timer& p_timer, const long p_seconds);
+    void writeResponses(boost::asio::yield_context p_yield);
+
+    boost::asio::io_service&                              m_service;         /**< Service executing the session's requests. */
+    const SessionLimits&                                  m_limits;          /**< Limits of resources used by the session. */
+    boost::atomic<std::size_t>&                           m_queuedRequests;  /**< Number of requests of all sessions waiting for execution. */
+    Strand                                                m_strand;          /**< Serializes access to the socket and the responses. */
+    boost::shared_ptr<SocketManager::Socket>              m_socket;          /**< Socket on which the client is connected. */
+    boost::shared_ptr<SocketManager>                      m_socketManager;   /**< Manager used to receive requests and send responses. */
+    std::deque<Response>                                  m_responses;       /**< Responses waiting to be sent. */
+    boost::atomic<std::size_t>                            m_pendingRequests; /**< Number of the session's requests waiting for execution. */
+    boost::asio::deadline_timer                           m_idleTimer;       /**< Closes the session when no request comes in time. */
+    boost::asio::deadline_timer                           m_writeTimer;      /**< Closes the session when responses aren't received in time. */
+    FinishHandler                                         m_finishHandler;   /**< Called when the session ends. */
 
-    std::map<std::string, boost::shared_ptr<ICommand> >   commands;   /**< */
-    boost::shared_ptr<boost::asio::ip::tcp::socket>       m_socket;   /**< Socket on which the client is connected. */
+    static const std::size_t STACK_SIZE            = 256 * 1024;   /**< Size of the session's coroutine stacks. */
+    static const std::size_t MAX_BATCHED_RESPONSES = 32;           /**< Maximal number of responses sent with one write. */
+    static const std::string BUSY_MESSAGE;                         /**< Error message of refused requests. */
 };
 
 #endif // SESSION_HPP
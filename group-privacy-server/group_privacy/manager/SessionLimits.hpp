@@ -0,0 +1,72 @@
+/**
+ * @file SessionLimits.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains a structure with limits which keep
+ * resources used by clients' sessions bounded.
+ */
+
+#ifndef SESSIONLIMITS_HPP
+#define	SESSIONLIMITS_HPP
+
+#include <cstddef>
+
+/**
+ * SessionLimits structure.
+ *
+ * Keeps memory and time used by clients bounded. Sessions that
+ * are idle for too long are closed, and requests which can't be
+ * executed soon enough are refused as busy instead of queued.
+ * A timeout of zero seconds means no timeout.
+ */
+struct SessionLimits
+{
+    /**
+     * Constructor of the SessionLimits structure.
+     *
+     * Sets default limits.
+     */
+    SessionLimits()
+        : maxSessions(1024),
+          maxQueuedRequests(4096),
+          maxSessionRequests(64),
+          maxRequestSize(4 * 1024 * 1024),
+          idleTimeout(300),
+          writeTimeout(60),
+          requestTimeout(30)
+    {
+    }
+
+    std::size_t   maxSessions;          /**< Maximal number of simultaneously open sessions. */
+    std::size_t   maxQueuedRequests;    /**< Maximal number of requests of all sessions waiting for execution. */
+    std::size_t   maxSessionRequests;   /**< Maximal number of requests of one session waiting for execution. */
+    std::size_t   maxRequestSize;       /**< Maximal size of a request in bytes. */
+    long          idleTimeout;          /**< Seconds within which a client has to send a whole request. */
+    long          writeTimeout;         /**< Seconds within which a client has to receive sent responses. */
+    long          requestTimeout;       /**< Seconds a request may wait for execution before it is refused,
+                                             and for a signature to be completed before it fails. */
+};
+
+#endif // SESSIONLIMITS_HPP
@@ -0,0 +1,101 @@
+/**
+ * @file BinaryIArchive.cpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains definitions of the methods from
+ * \c BinaryIArchive class.
+ */
+
+#include "BinaryIArchive.hpp"
+
+#include "BinaryOArchive.hpp"
+
+#include <stdexcept>
+
+BinaryIArchive::BinaryIArchive(const char* p_data, const std::size_t p_size)
+    : m_position(reinterpret_cast<const unsigned char*>(p_data)),
+      m_end(reinterpret_cast<const unsigned char*>(p_data) + p_size)
+{
+    if(*take(1) != BinaryOArchive::FORMAT_VERSION)
+        throw std::runtime_error("Unsupported version of the binary format!");
+    m_elementWidth = loadLength();
+}
+
+void BinaryIArchive::load(bool& p_value)
+{
+    p_value = *take(1) != 0;
+}
+
+void BinaryIArchive::load(std::string& p_value)
+{
+    const std::size_t l_length = loadLength();
+    p_value.assign(reinterpret_cast<const char*>(take(l_length)), l_length);
+}
+
+void BinaryIArchive::load(BigInteger& p_value)
+{
+    const unsigned char l_tag = *take(1);
+    if(l_tag == BinaryOArchive::FIXED_WIDTH)
+    {
+        if(m_elementWidth == 0)
+            throw std::runtime_error("Group element written without its width!");
+        p_value.fromBytes(take(m_elementWidth), m_elementWidth);
+        return;
+    }
+    if(l_tag != BinaryOArchive::NON_NEGATIVE && l_tag != BinaryOArchive::NEGATIVE)
+        throw std::runtime_error("Invalid tag of a serialized number!");
+    const bool l_negative = (l_tag == BinaryOArchive::NEGATIVE);
+    const std::size_t l_length = loadLength();
+    const unsigned char* l_bytes = take(l_length);
+    if(l_length == 0)
+        p_value = 0ul;
+    else
+        p_value.fromBytes(l_bytes, l_length);
+    if(l_negative)
+        p_value = -p_value;
+}
+
+std::size_t BinaryIArchive::loadLength()
+{
+    return static_cast<std::size_t>(loadNumber(4));
+}
+
+boost::uint64_t BinaryIArchive::loadNumber(const std::size_t p_size)
+{
+    const unsigned char* l_bytes = take(p_size);
+    boost::uint64_t l_value = 0;
+    for(std::size_t i = 0; i < p_size; ++i)
+        l_value = (l_value << 8) | l_bytes[i];
+    return l_value;
+}
+
+const unsigned char* BinaryIArchive::take(const std::size_t p_size)
+{
+    if(static_cast<std::size_t>(m_end - m_position) < p_size)
+        throw std::runtime_error("Serialized data ends too early!");
+    const unsigned char* l_bytes = m_position;
+    m_position += p_size;
+    return l_bytes;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file BinaryOArchive.cpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains definitions of the methods from
+ * \c BinaryOArchive class.
+ */
+
+#include "BinaryOArchive.hpp"
+
+#include "../mpi/BigIntegerComparisonOperators.hpp"
+
+#include <stdexcept>
+
+const unsigned char BinaryOArchive::FORMAT_VERSION;
+const unsigned char BinaryOArchive::NON_NEGATIVE;
+const unsigned char BinaryOArchive::NEGATIVE;
+const unsigned char BinaryOArchive::FIXED_WIDTH;
+
+BinaryOArchive::BinaryOArchive(std::string& p_buffer, const std::size_t p_elementWidth)
+    : m_buffer(p_buffer),
+      m_elementWidth(p_elementWidth)
+{
+    m_buffer.push_back(static_cast<char>(FORMAT_VERSION));
+    saveLength(m_elementWidth);
+}
+
+void BinaryOArchive::save(const bool p_value)
+{
+    m_buffer.push_back(p_value ? 1 : 0);
+}
+
+void BinaryOArchive::save(const std::string& p_value)
+{
+    saveLength(p_value.size());
+    m_buffer.append(p_value);
+}
+
+void BinaryOArchive::save(const BigInteger& p_value)
+{
+    const bool l_negative = p_value < BigInteger(0ul);
+    // Small numbers, e.g. indexes, are shorter with their lengths.
+    const std::size_t l_valueLength = p_value.getNumberOfBytes();
+    if(!l_negative && m_elementWidth > 0
+       && l_valueLength <= m_elementWidth && l_valueLength + 4 > m_elementWidth)
+    {
+        m_buffer.push_back(static_cast<char>(FIXED_WIDTH));
+        const std::size_t l_offset = m_buffer.size();
+        m_buffer.resize(l_offset + m_elementWidth);
+        p_value.toBytes(reinterpret_cast<unsigned char*>(&m_buffer[l_offset]), m_elementWidth);
+        return;
+    }
+    const BigInteger l_absolute = l_negative ? -p_value : p_value;
+    const std::size_t l_length = l_absolute.getNumberOfBytes();
+    m_buffer.push_back(static_cast<char>(l_negative ? NEGATIVE : NON_NEGATIVE));
+    saveLength(l_length);
+    const std::size_t l_offset = m_buffer.size();
+    m_buffer.resize(l_offset + l_length);
+    if(l_length > 0)
+        l_absolute.toBytes(reinterpret_cast<unsigned char*>(&m_buffer[l_offset]), l_length);
+}
+
+void BinaryOArchive::saveLength(const std::size_t p_length)
+{
+    if(static_cast<boost::uint64_t>(p_length) > 0xFFFFFFFFu)
+        throw std::runtime_error("Value is too long to be serialized!");
+    saveNumber(p_length, 4);
+}
+
+void BinaryOArchive::saveNumber(const boost::uint64_t p_value, const std::size_t p_size)
+{
+    for(std::size_t i = 0; i < p_size; ++i)
+        m_buffer.push_back(static_cast<char>(p_value >> (8 * (p_size - 1 - i))));
+}
@@ -0,0 +1,88 @@
+/**
+ * @file CompletedSignaturesStore.cpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ */
+
+#include "CompletedSignaturesStore.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <stdexcept>
+
+CompletedSignaturesStore::SerializedSignature CompletedSignaturesStore::find(const unsigned int signatureIndex) const
+{
+    boost::mutex::scoped_lock lock(mutex);
+    Signatures::const_iterator it = signatures.find(signatureIndex);
+    if(it == signatures.end())
+        return SerializedSignature();
+    return checkCompleted(signatureIndex, it->second);
+}
+
+void CompletedSignaturesStore::insert(const unsigned int signatureIndex, const SerializedSignature& signature)
+{
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        signatures[signatureIndex] = signature;
+    }
+    signatureCompleted.notify_all();
+}
+
+void CompletedSignaturesStore::markFailed(const unsigned int signatureIndex)
+{
+    insert(signatureIndex, SerializedSignature());
+}
+
+void CompletedSignaturesStore::erase(const unsigned int signatureIndex)
+{
+    boost::mutex::scoped_lock lock(mutex);
+    signatures.erase(signatureIndex);
+}
+
+CompletedSignaturesStore::SerializedSignature CompletedSignaturesStore::waitFor(
+    const unsigned int signatureIndex,
+    const boost::posix_time::time_duration& timeout) const
+{
+    const bool bounded = (timeout > boost::posix_time::time_duration());
+    const boost::posix_time::ptime deadline = boost::posix_time::microsec_clock::universal_time() + timeout;
+    boost::mutex::scoped_lock lock(mutex);
+    Signatures::const_iterator it;
+    while((it = signatures.find(signatureIndex)) == signatures.end())
+    {
+        if(!bounded)
+            signatureCompleted.wait(lock);
+        else if(!signatureCompleted.timed_wait(lock, deadline) && signatures.find(signatureIndex) == signatures.end())
+            throw std::runtime_error("Signature " + boost::lexical_cast<std::string>(signatureIndex) + " not completed in time!");
+    }
+    return checkCompleted(signatureIndex, it->second);
+}
+
+const CompletedSignaturesStore::SerializedSignature& CompletedSignaturesStore::checkCompleted(
+    const unsigned int signatureIndex,
+    const SerializedSignature& signature)
+{
+    if(!signature)
+        throw std::runtime_error("Signature " + boost::lexical_cast<std::string>(signatureIndex) + " couldn't be completed!");
+    return signature;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file CompletedSignaturesStore.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains CompletedSignaturesStore class which keeps
+ * step-out group signatures that have been finalized by all signers.
+ */
+
+#ifndef COMPLETEDSIGNATURESSTORE_HPP
+#define	COMPLETEDSIGNATURESSTORE_HPP
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <string>
+
+/**
+ * CompletedSignaturesStore class.
+ *
+ * Keeps signatures whose ThetaPrim has been assembled from shares
+ * of all signers. Signatures are kept already serialized and are
+ * never modified, so they can be sent to any number of clients
+ * without being copied or computed again.
+ *
+ * Signatures are stored under handles of pending signatures they
+ * were created from. Entries have to be erased when their handles
+ * are released, before the handles can be used again.
+ */
+class CompletedSignaturesStore : private boost::noncopyable
+{
+public:
+    typedef boost::shared_ptr<const std::string> SerializedSignature;
+
+    /**
+     * Returns a completed signature.
+     *
+     * @param signatureIndex Index number of the signature.
+     *
+     * @return Serialized signature or an empty pointer if the signature is not completed.
+     *
+     * @throw std::runtime_error If the signature couldn't be completed.
+     */
+    SerializedSignature find(const unsigned int signatureIndex) const;
+
+    /**
+     * Stores a completed signature and wakes up all threads waiting for it.
+     *
+     * @param signatureIndex Index number of the signature.
+     * @param signature Serialized signature.
+     */
+    void insert(const unsigned int signatureIndex, const SerializedSignature& signature);
+
+    /**
+     * Records that a signature couldn't be completed
+     * and wakes up all threads waiting for it.
+     *
+     * @param signatureIndex Index number of the signature.
+     */
+    void markFailed(const unsigned int signatureIndex);
+
+    /**
+     * Removes a signature. Does nothing if there is no such signature.
+     *
+     * @param signatureIndex Index number of the signature.
+     */
+    void erase(const unsigned int signatureIndex);
+
+    /**
+     * Waits until a signature is completed and returns it.
+     *
+     * @param signatureIndex Index number of the signature.
+     * @param timeout Maximal time of waiting. Not positive if there is no limit.
+     *
+     * @return Serialized signature.
+     *
+     * @throw std::runtime_error If the signature couldn't be completed or the time has run out.
+     */
+    SerializedSignature waitFor(const unsigned int signatureIndex,
+                                const boost::posix_time::time_duration& timeout) const;
+private:
+    typedef boost::unordered_map<unsigned int, SerializedSignature> Signatures;   /**< An empty pointer marks a failed signature. */
+
+    static const SerializedSignature& checkCompleted(const unsigned int signatureIndex,
+                                                     const SerializedSignature& signature);
+
+    mutable boost::mutex                mutex;
+    mutable boost::condition_variable   signatureCompleted;
+    Signatures                          signatures;
+};
+
+#endif // COMPLETEDSIGNATURESSTORE_HPP
@@ -0,0 +1,70 @@
+/**
+ * @file ParametersBundle.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains ParametersBundle class which keeps
+ * serialized group parameters signed by Group Privacy Server,
+ * so that signatures can be verified without connecting to it.
+ */
+
+#ifndef PARAMETERSBUNDLE_HPP
+#define	PARAMETERSBUNDLE_HPP
+
+#include "Sigma.hpp"
+
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/tuple/tuple.hpp>
+
+#include <string>
+
+class ParametersBundle : public boost::tuple<unsigned int, std::string, Sigma>
+{
+    friend class boost::serialization::access;
+public:
+    static const unsigned int VERSION = 1;   /**< Version of the bundle's format. */
+
+    ParametersBundle();
+    ParametersBundle(const unsigned int version, const std::string& parameters, const Sigma& sigma);
+    ParametersBundle(const ParametersBundle& bundle);
+    ParametersBundle& operator=(const ParametersBundle& bundle);
+    const unsigned int& getVersion() const;
+    unsigned int& getVersion();
+    const std::string& getParameters() const;
+    std::string& getParameters();
+    const Sigma& getSigma() const;
+    Sigma& getSigma();
+    static std::string createSignedText(const unsigned int version, const std::string& parameters);
+private:
+    template<typename Archive>
+    void serialize(Archive& archive, const unsigned int version)
+    {
+        archive & getVersion();
+        archive & getParameters();
+        archive & getSigma();
+    }
+};
+
+#endif // PARAMETERSBUNDLE_HPP
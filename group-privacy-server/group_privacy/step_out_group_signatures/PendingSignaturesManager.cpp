@@ -27,19 +27,114 @@
 
 #include "PendingSignaturesManager.hpp"
 
+#include "StepOutGroupSignaturesConstants.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/foreach.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+const std::time_t PendingSignaturesManager::NEVER = std::numeric_limits<std::time_t>::max();
+
+PendingSignaturesManager::Access::Access(PendingSignaturesManager& manager, const unsigned int signatureIndex)
+    : manager(manager),
+      signatureIndex(signatureIndex),
+      slot(manager.findSlot(signatureIndex)),
+      lock(slot.mutex)
+{
+    if(!slot.occupied || slot.generation != (signatureIndex >> SLOT_BITS))
+        throw std::runtime_error("Signature " + boost::lexical_cast<std::string>(signatureIndex) + " doesn't exist!");
+    slot.deadline = PendingSignaturesManager::deadline();
+}
+
+PendingSignature& PendingSignaturesManager::Access::operator*() const
+{
+    return slot.pendingSignature();
+}
+
+PendingSignature* PendingSignaturesManager::Access::operator->() const
+{
+    return &slot.pendingSignature();
+}
+
+bool PendingSignaturesManager::Access::beginCompletion()
+{
+    if(slot.completing)
+        return false;
+    slot.completing = true;
+    return true;
+}
+
+void PendingSignaturesManager::Access::retire()
+{
+    const long retention = manager.retentionPeriod.load();
+    slot.pendingSignature().~PendingSignature();
+    slot.occupied = false;
+    slot.completing = false;
+    slot.retired = true;
+    slot.deadline = (retention > 0 ? std::time(NULL) + retention : NEVER);
+    if(slot.deadline != NEVER)
+    {
+        boost::mutex::scoped_lock slabLock(manager.slabMutex);
+        manager.schedule(signatureIndex, slot.deadline);
+    }
+}
+
+PendingSignature& PendingSignaturesManager::Slot::pendingSignature()
+{
+    return *reinterpret_cast<PendingSignature*>(storage.address());
+}
+
+PendingSignaturesManager::PendingSignaturesManager()
+    : usedSlots(0),
+      currentTick(std::time(NULL) / TICK_DURATION),
+      retentionPeriod(SGS::COMPLETED_SIGNATURE_RETENTION)
+{
+    for(std::size_t i = 0; i < NUMBER_OF_CHUNKS; ++i)
+        chunks[i].store(0, boost::memory_order_relaxed);
+}
+
+PendingSignaturesManager::~PendingSignaturesManager()
+{
+    for(std::size_t i = 0; i < NUMBER_OF_CHUNKS; ++i)
+    {
+        Slot* chunk = chunks[i].load(boost::memory_order_acquire);
+        if(!chunk)
+            continue;
+        for(std::size_t j = 0; j < CHUNK_SIZE; ++j)
+        {
+            if(chunk[j].occupied)
+                chunk[j].pendingSignature().~PendingSignature();
+        }
+        delete[] chunk;
+    }
+}
+
 unsigned int PendingSignaturesManager::addPendingSignature(
     const unsigned int userIndex,
     const std::string& message,
     const BigInteger& t,
     const BigInteger& x)
 {
-    return addPendingSignature(PendingSignature(userIndex, message, t, x));
-}
-
-unsigned int PendingSignaturesManager::addPendingSignature(const PendingSignature& pendingSignature)
-{
-    pendingSignatures.push_back(pendingSignature);
-    return (pendingSignatures.size() - 1);
+    const unsigned int slotIndex = acquireSlot();
+    Slot& slot = slotAt(slotIndex);
+    unsigned int signatureIndex;
+    std::time_t signatureDeadline = deadline();
+    {
+        boost::mutex::scoped_lock lock(slot.mutex);
+        new (slot.storage.address()) PendingSignature(userIndex, message, t, x);
+        slot.occupied = true;
+        slot.deadline = signatureDeadline;
+        signatureIndex = createHandle(slot.generation, slotIndex);
+    }
+    boost::mutex::scoped_lock lock(slabMutex);
+    schedule(signatureIndex, signatureDeadline);
+    return signatureIndex;
 }
 
 bool PendingSignaturesManager::addUserToPendingSignature(
@@ -47,24 +142,118 @@ bool PendingSignaturesManager::addUserToPendingSignature(
     const unsigned int userIndex,
     const BigInteger& xt)
 {
-    BOOST_ASSERT(signatureIndex < pendingSignatures.size());
-    return pendingSignatures[signatureIndex].addUser(userIndex, xt);
+    Access pendingSignature(*this, signatureIndex);
+    return pendingSignature->addUser(userIndex, xt);
 }
 
 bool PendingSignaturesManager::closePendingSignature(const unsigned int signatureIndex, const unsigned int userIndex)
 {
-    BOOST_ASSERT(signatureIndex < pendingSignatures.size());
-    return pendingSignatures[signatureIndex].closeSignature(userIndex);
+    Access pendingSignature(*this, signatureIndex);
+    return pendingSignature->closeSignature(userIndex);
+}
+
+std::vector<unsigned int> PendingSignaturesManager::expirePendingSignatures()
+{
+    const std::time_t now = std::time(NULL);
+    std::vector<unsigned int> dueSignatures;
+    {
+        boost::mutex::scoped_lock lock(slabMutex);
+        const std::time_t tick = now / TICK_DURATION;
+        for(std::size_t i = 0; currentTick < tick && i < WHEEL_SIZE; ++i)
+        {
+            std::vector<unsigned int>& bucket = wheel[(currentTick + 1) % WHEEL_SIZE];
+            dueSignatures.insert(dueSignatures.end(), bucket.begin(), bucket.end());
+            bucket.clear();
+            ++currentTick;
+        }
+        currentTick = std::max(currentTick, tick);
+    }
+    std::vector<unsigned int> expiredSignatures;
+    std::vector<unsigned int> expiredSlots;
+    std::vector<std::pair<unsigned int, std::time_t> > postponedSignatures;
+    BOOST_FOREACH(const unsigned int signatureIndex, dueSignatures)
+    {
+        Slot& slot = slotAt(signatureIndex & SLOT_MASK);
+        boost::mutex::scoped_lock lock(slot.mutex);
+        if((!slot.occupied && !slot.retired) || slot.generation != (signatureIndex >> SLOT_BITS))
+            continue;
+        if(slot.deadline == NEVER)
+            continue;
+        if(slot.deadline > now || slot.completing)
+        {
+            postponedSignatures.push_back(std::make_pair(signatureIndex, slot.deadline));
+            continue;
+        }
+        releaseSlot(slot);
+        expiredSignatures.push_back(signatureIndex);
+        expiredSlots.push_back(signatureIndex & SLOT_MASK);
+    }
+    boost::mutex::scoped_lock lock(slabMutex);
+    freeSlots.insert(freeSlots.end(), expiredSlots.begin(), expiredSlots.end());
+    for(std::size_t i = 0; i < postponedSignatures.size(); ++i)
+        schedule(postponedSignatures[i].first, postponedSignatures[i].second);
+    return expiredSignatures;
+}
+
+unsigned int PendingSignaturesManager::createHandle(const unsigned int generation, const unsigned int slotIndex)
+{
+    return ((generation << SLOT_BITS) | slotIndex);
+}
+
+std::time_t PendingSignaturesManager::deadline()
+{
+    return std::time(NULL) + SGS::PENDING_SIGNATURE_TIMEOUT;
+}
+
+unsigned int PendingSignaturesManager::acquireSlot()
+{
+    boost::mutex::scoped_lock lock(slabMutex);
+    if(!freeSlots.empty())
+    {
+        unsigned int slotIndex = freeSlots.back();
+        freeSlots.pop_back();
+        return slotIndex;
+    }
+    if(usedSlots > SLOT_MASK)
+        throw std::runtime_error("Too many pending signatures!");
+    if(usedSlots % CHUNK_SIZE == 0)
+        chunks[usedSlots / CHUNK_SIZE].store(new Slot[CHUNK_SIZE], boost::memory_order_release);
+    return usedSlots++;
+}
+
+PendingSignaturesManager::Slot& PendingSignaturesManager::findSlot(const unsigned int signatureIndex)
+{
+    const unsigned int slotIndex = signatureIndex & SLOT_MASK;
+    Slot* chunk = chunks[slotIndex / CHUNK_SIZE].load(boost::memory_order_acquire);
+    if(!chunk)
+        throw std::runtime_error("Signature " + boost::lexical_cast<std::string>(signatureIndex) + " doesn't exist!");
+    return chunk[slotIndex % CHUNK_SIZE];
+}
+
+void PendingSignaturesManager::releaseSlot(Slot& slot)
+{
+    if(slot.occupied)
+        slot.pendingSignature().~PendingSignature();
+    slot.occupied = false;
+    slot.completing = false;
+    slot.retired = false;
+    slot.generation = (slot.generation + 1) & GENERATION_MASK;
+}
+
+PendingSignaturesManager::Slot& PendingSignaturesManager::slotAt(const unsigned int slotIndex) const
+{
+    Slot* chunk = chunks[slotIndex / CHUNK_SIZE].load(boost::memory_order_acquire);
+    BOOST_ASSERT(chunk);
+    return chunk[slotIndex % CHUNK_SIZE];
 }
 
-const PendingSignature& PendingSignaturesManager::getPendingSignature(const unsigned int signatureIndex) const
+void PendingSignaturesManager::setRetentionPeriod(const long seconds)
 {
-    BOOST_ASSERT(signatureIndex < pendingSignatures.size());
-    return pendingSignatures[signatureIndex];
+    retentionPeriod.store(seconds);
 }
 
-PendingSignature& PendingSignaturesManager::getPendingSignature(const unsigned int signatureIndex)
+void PendingSignaturesManager::schedule(const unsigned int signatureIndex, const std::time_t deadline)
 {
-    BOOST_ASSERT(signatureIndex < pendingSignatures.size());
-    return pendingSignatures[signatureIndex];
+    const std::time_t tick = std::max(deadline / TICK_DURATION, currentTick + 1);
+    wheel[tick % WHEEL_SIZE].push_back(signatureIndex);
 }
@@ -31,27 +31,157 @@
 #include "../mpi/BigInteger.hpp"
 #include "PendingSignature.hpp"
 
+#include <boost/array.hpp>
+#include <boost/atomic.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <cstddef>
+#include <ctime>
 #include <string>
 #include <vector>
 
-class PendingSignaturesManager
+/**
+ * PendingSignaturesManager class.
+ *
+ * Keeps signatures that are being created by many users.
+ *
+ * Pending signatures are constructed in place in slots of a slab
+ * which grows in chunks that are never moved. Slots of removed
+ * signatures are reused. A signature is identified by a handle
+ * which combines slot's number with slot's generation, so a handle
+ * of a removed signature never refers to a signature that reuses its slot.
+ *
+ * Signatures that nobody has accessed for \c SGS::PENDING_SIGNATURE_TIMEOUT
+ * seconds are considered abandoned and removed by a timer wheel.
+ *
+ * A signature that is being completed doesn't expire. Once completed,
+ * it is retired rather than removed: its data is dropped, but its slot
+ * is kept for the retention period, so that the handle stays unique
+ * while the completed signature is kept elsewhere under it. With no
+ * retention period retired slots are never reused. Handles of released
+ * slots are reported by expirePendingSignatures().
+ */
+class PendingSignaturesManager : private boost::noncopyable
 {
+private:
+    struct Slot;
 public:
+    /**
+     * Access class.
+     *
+     * Gives exclusive access to a pending signature
+     * for the lifetime of the object.
+     */
+    class Access : private boost::noncopyable
+    {
+    public:
+        /**
+         * Locks a pending signature of a given handle.
+         *
+         * @param manager Manager which keeps the signature.
+         * @param signatureIndex Handle of the signature.
+         *
+         * @throw std::runtime_error If there is no such signature.
+         */
+        Access(PendingSignaturesManager& manager, const unsigned int signatureIndex);
+        PendingSignature& operator*() const;
+        PendingSignature* operator->() const;
+
+        /**
+         * Keeps the signature from expiring until it is retired.
+         *
+         * @return False if completion of the signature has already begun.
+         */
+        bool beginCompletion();
+
+        /**
+         * Retires the signature. It can't be accessed anymore, but its
+         * handle isn't reused until the retention period passes.
+         * The signature mustn't be used through this object afterwards.
+         */
+        void retire();
+    private:
+        PendingSignaturesManager&   manager;
+        const unsigned int          signatureIndex;
+        Slot&                       slot;
+        boost::mutex::scoped_lock   lock;
+    };
+
+    PendingSignaturesManager();
+    ~PendingSignaturesManager();
+
+    /**
+     * Creates a new pending signature with open status.
+     *
+     * @return Handle of the new signature.
+     */
     unsigned int addPendingSignature(
         const unsigned int userIndex,
         const std::string& message,
         const BigInteger& t,
         const BigInteger& x);
-    unsigned int addPendingSignature(const PendingSignature& pendingSignature);
     bool addUserToPendingSignature(
         const unsigned int signatureIndex,
         const unsigned int userIndex,
         const BigInteger& xt);
     bool closePendingSignature(const unsigned int signatureIndex, const unsigned int userIndex);
-    const PendingSignature& getPendingSignature(const unsigned int signatureIndex) const;
-    PendingSignature& getPendingSignature(const unsigned int signatureIndex);
+
+    /**
+     * Removes signatures and frees retired slots whose deadlines have passed.
+     *
+     * @return Handles which have become invalid.
+     */
+    std::vector<unsigned int> expirePendingSignatures();
+
+    /**
+     * Sets the time for which handles of retired signatures stay reserved.
+     *
+     * @param seconds Number of seconds. Zero if handles are reserved forever.
+     */
+    void setRetentionPeriod(const long seconds);
 private:
-    std::vector<PendingSignature> pendingSignatures;
+    struct Slot
+    {
+        Slot() : generation(0), occupied(false), completing(false), retired(false), deadline(0) {}
+        PendingSignature& pendingSignature();
+
+        boost::mutex                                         mutex;        /**< Guards all other fields. */
+        unsigned int                                         generation;   /**< Bumped whenever the slot is freed. */
+        bool                                                 occupied;
+        bool                                                 completing;   /**< True if the signature mustn't expire. */
+        bool                                                 retired;      /**< True if the handle is kept after the signature is gone. */
+        std::time_t                                          deadline;
+        boost::aligned_storage<sizeof(PendingSignature),
+                               boost::alignment_of<PendingSignature>::value>   storage;
+    };
+
+    static const unsigned int   SLOT_BITS          = 20;                        /**< Handle = generation << SLOT_BITS | slot. */
+    static const unsigned int   SLOT_MASK          = (1u << SLOT_BITS) - 1;
+    static const unsigned int   GENERATION_MASK    = (~0u) >> SLOT_BITS;
+    static const std::size_t    CHUNK_SIZE         = 1024;
+    static const std::size_t    NUMBER_OF_CHUNKS   = (SLOT_MASK + 1) / CHUNK_SIZE;
+    static const std::time_t    TICK_DURATION      = 10;                        /**< Resolution of the timer wheel in seconds. */
+    static const std::size_t    WHEEL_SIZE         = 64;
+    static const std::time_t    NEVER;                                          /**< Deadline of slots which never expire. */
+
+    static unsigned int createHandle(const unsigned int generation, const unsigned int slotIndex);
+    static std::time_t deadline();
+    unsigned int acquireSlot();
+    Slot& findSlot(const unsigned int signatureIndex);
+    static void releaseSlot(Slot& slot);
+    Slot& slotAt(const unsigned int slotIndex) const;
+    void schedule(const unsigned int signatureIndex, const std::time_t deadline);
+
+    boost::array<boost::atomic<Slot*>, NUMBER_OF_CHUNKS>          chunks;          /**< Lazily allocated chunks of slots. */
+    boost::mutex                                                  slabMutex;       /**< Guards all members below. Locked after mutexes of slots. */
+    unsigned int                                                  usedSlots;       /**< Number of slots ever used. */
+    std::vector<unsigned int>                                     freeSlots;
+    boost::array<std::vector<unsigned int>, WHEEL_SIZE>           wheel;           /**< Handles scheduled for expiry. */
+    std::time_t                                                   currentTick;
+    boost::atomic<long>                                           retentionPeriod; /**< Seconds for which retired slots are kept. Zero means forever. */
 };
 
 #endif // PENDINGSIGNATURESMANAGER_HPP
@@ -0,0 +1,146 @@
+/**
+ * @file PublishedValuesStore.cpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ */
+
+#include "PublishedValuesStore.hpp"
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+
+const std::size_t NO_RECORD = static_cast<std::size_t>(-1);
+
+} // namespace
+
+boost::optional<PublishedValues> PublishedValuesStore::find(const unsigned int userIndex, const BigInteger& t) const
+{
+    EncodedValue encodedT;
+    if(!encode(t, encodedT))
+        return boost::none;
+    const Shard& shard = shardOf(userIndex);
+    boost::mutex::scoped_lock lock(shard.mutex);
+    std::size_t offset = findRecord(shard, createKey(userIndex, encodedT), encodedT);
+    if(offset == NO_RECORD)
+        return boost::none;
+    return decode(&shard.records[offset]);
+}
+
+std::vector<std::pair<unsigned int, PublishedValues> > PublishedValuesStore::findAll(const BigInteger& t) const
+{
+    std::vector<std::pair<unsigned int, PublishedValues> > usersPublishedValues;
+    EncodedValue encodedT;
+    if(!encode(t, encodedT))
+        return usersPublishedValues;
+    const std::size_t hash = boost::hash_range(encodedT.begin(), encodedT.end());
+    for(std::size_t i = 0; i < shards.size(); ++i)
+    {
+        const Shard& shard = shards[i];
+        boost::mutex::scoped_lock lock(shard.mutex);
+        std::pair<TIndex::const_iterator, TIndex::const_iterator> candidates = shard.tIndex.equal_range(hash);
+        for(TIndex::const_iterator it = candidates.first; it != candidates.second; ++it)
+        {
+            const unsigned char* record = &shard.records[it->second.second];
+            if(std::memcmp(record, encodedT.data(), VALUE_SIZE) == 0)
+                usersPublishedValues.push_back(std::make_pair(it->second.first, decode(record)));
+        }
+    }
+    std::sort(usersPublishedValues.begin(), usersPublishedValues.end());
+    return usersPublishedValues;
+}
+
+bool PublishedValuesStore::insert(const unsigned int userIndex,
+                                  const PublishedValues& publishedValues,
+                                  const BigInteger& q)
+{
+    boost::array<EncodedValue, 4> encoded;
+    if(!encodeElement(publishedValues.getT(), q, encoded[0]) ||
+       !encodeElement(publishedValues.getXt(), q, encoded[1]) ||
+       !encodeElement(publishedValues.getPt(), q, encoded[2]) ||
+       !encodeElement(publishedValues.getMt(), q, encoded[3]))
+        return false;
+    IndexKey key = createKey(userIndex, encoded[0]);
+    Shard& shard = shardOf(userIndex);
+    boost::mutex::scoped_lock lock(shard.mutex);
+    if(findRecord(shard, key, encoded[0]) != NO_RECORD)
+        return true;
+    std::size_t offset = shard.records.size();
+    shard.records.resize(offset + RECORD_SIZE);
+    for(std::size_t i = 0; i < encoded.size(); ++i)
+        std::copy(encoded[i].begin(), encoded[i].end(), shard.records.begin() + offset + i * VALUE_SIZE);
+    shard.index.insert(Index::value_type(key, offset));
+    shard.tIndex.insert(TIndex::value_type(key.second, Record(userIndex, offset)));
+    return true;
+}
+
+PublishedValues PublishedValuesStore::decode(const unsigned char* record)
+{
+    PublishedValues publishedValues;
+    publishedValues.getT().fromBytes(record, VALUE_SIZE);
+    publishedValues.getXt().fromBytes(record + VALUE_SIZE, VALUE_SIZE);
+    publishedValues.getPt().fromBytes(record + 2 * VALUE_SIZE, VALUE_SIZE);
+    publishedValues.getMt().fromBytes(record + 3 * VALUE_SIZE, VALUE_SIZE);
+    return publishedValues;
+}
+
+bool PublishedValuesStore::encode(const BigInteger& value, EncodedValue& encoded)
+{
+    return value.toBytes(encoded.c_array(), encoded.size());
+}
+
+bool PublishedValuesStore::encodeElement(const BigInteger& value, const BigInteger& q, EncodedValue& encoded)
+{
+    return (value < q && encode(value, encoded));
+}
+
+PublishedValuesStore::IndexKey PublishedValuesStore::createKey(const unsigned int userIndex, const EncodedValue& t)
+{
+    return IndexKey(userIndex, boost::hash_range(t.begin(), t.end()));
+}
+
+std::size_t PublishedValuesStore::findRecord(const Shard& shard, const IndexKey& key, const EncodedValue& t)
+{
+    std::pair<Index::const_iterator, Index::const_iterator> candidates = shard.index.equal_range(key);
+    for(Index::const_iterator it = candidates.first; it != candidates.second; ++it)
+    {
+        if(std::memcmp(&shard.records[it->second], t.data(), VALUE_SIZE) == 0)
+            return it->second;
+    }
+    return NO_RECORD;
+}
+
+PublishedValuesStore::Shard& PublishedValuesStore::shardOf(const unsigned int userIndex)
+{
+    return shards[userIndex % NUMBER_OF_SHARDS];
+}
+
+const PublishedValuesStore::Shard& PublishedValuesStore::shardOf(const unsigned int userIndex) const
+{
+    return shards[userIndex % NUMBER_OF_SHARDS];
+}
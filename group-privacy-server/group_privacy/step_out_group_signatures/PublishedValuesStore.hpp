@@ -0,0 +1,125 @@
+/**
+ * @file PublishedValuesStore.hpp
+ * @author Pawel Kieliszczyk <pawel.kieliszczyk@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2011 Pawel Kieliszczyk
+ *
+ * This file is part of Group Privacy.
+ *
+ * Group Privacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Group Privacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Group Privacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The file contains PublishedValuesStore class which keeps
+ * values published by users for the Check procedure.
+ */
+
+#ifndef PUBLISHEDVALUESSTORE_HPP
+#define	PUBLISHEDVALUESSTORE_HPP
+
+#include "../mpi/BigInteger.hpp"
+#include "PublishedValues.hpp"
+#include "StepOutGroupSignaturesConstants.hpp"
+
+#include <boost/array.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * PublishedValuesStore class.
+ *
+ * Keeps values published by users. The store is split into shards
+ * selected by user's index number, each guarded by its own mutex,
+ * so that sessions of different users do not contend with each other.
+ *
+ * Every published tuple (t, x(t), P(t), m(t)) is kept as a fixed-size
+ * record of big-endian field elements in a contiguous buffer of its shard.
+ * Records are found with a hash index keyed by user's index number
+ * and a hash of t, so a lookup doesn't depend on the number
+ * of signatures a user has published values for. Another index,
+ * keyed by a hash of t only, finds values of all users for a t.
+ */
+class PublishedValuesStore : private boost::noncopyable
+{
+public:
+    /**
+     * Returns values published by a user for a given t.
+     *
+     * @param userIndex Index number of the user.
+     * @param t Value t of a signature.
+     *
+     * @return Published values if the user has published them. Nothing otherwise.
+     */
+    boost::optional<PublishedValues> find(const unsigned int userIndex, const BigInteger& t) const;
+
+    /**
+     * Returns values published by all users for a given t.
+     *
+     * @param t Value t of a signature.
+     *
+     * @return Users' index numbers and their published values.
+     */
+    std::vector<std::pair<unsigned int, PublishedValues> > findAll(const BigInteger& t) const;
+
+    /**
+     * Stores values published by a user. Values already published
+     * for the same t are kept.
+     *
+     * @param userIndex Index number of the user.
+     * @param publishedValues Published values.
+     * @param q Order of the group. Published values have to be elements of Zq.
+     *
+     * @return False if the values are not elements of Zq. True otherwise.
+     */
+    bool insert(const unsigned int userIndex, const PublishedValues& publishedValues, const BigInteger& q);
+private:
+    static const std::size_t   VALUE_SIZE         = (SGS::COEFFICIENTS_NBITS + 7) / 8;   /**< Size of a field element. */
+    static const std::size_t   RECORD_SIZE        = 4 * VALUE_SIZE;                       /**< Size of (t, xt, Pt, mt). */
+    static const std::size_t   NUMBER_OF_SHARDS   = 64;
+
+    typedef boost::array<unsigned char, VALUE_SIZE>                  EncodedValue;
+    typedef std::pair<unsigned int, std::size_t>                     IndexKey;   /**< User's index and hash of t. */
+    typedef boost::unordered_multimap<IndexKey, std::size_t>         Index;      /**< Maps keys to records' offsets. */
+    typedef std::pair<unsigned int, std::size_t>                     Record;     /**< User's index and record's offset. */
+    typedef boost::unordered_multimap<std::size_t, Record>           TIndex;     /**< Maps hashes of t to records. */
+
+    struct Shard
+    {
+        mutable boost::mutex         mutex;
+        std::vector<unsigned char>   records;
+        Index                        index;
+        TIndex                       tIndex;
+    };
+
+    static bool encode(const BigInteger& value, EncodedValue& encoded);
+    static bool encodeElement(const BigInteger& value, const BigInteger& q, EncodedValue& encoded);
+    static IndexKey createKey(const unsigned int userIndex, const EncodedValue& t);
+    static PublishedValues decode(const unsigned char* record);
+    static std::size_t findRecord(const Shard& shard, const IndexKey& key, const EncodedValue& t);
+    Shard& shardOf(const unsigned int userIndex);
+    const Shard& shardOf(const unsigned int userIndex) const;
+
+    boost::array<Shard, NUMBER_OF_SHARDS> shards;
+};
+
+#endif // PUBLISHEDVALUESSTORE_HPP
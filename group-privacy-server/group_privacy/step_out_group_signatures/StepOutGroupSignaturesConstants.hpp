@@ -38,6 +38,11 @@ namespace SGS
 // Security related constants:
 const unsigned int   COEFFICIENTS_NBITS         = 64;                            /**< Number of bits of polynomials' coefficients. */
 const unsigned int   RSA_KEY_NBITS              = 2048;                          /**< Number of bits of RSA key. */
+const std::size_t    MESSAGE_DIGEST_LENGTH      = 64;                            /**< Number of hexadecimal digits of a message's SHA-256 digest signed in place of the message. */
+
+// Server's resources related constants:
+const unsigned int   PENDING_SIGNATURE_TIMEOUT  = 600;                           /**< Number of seconds after which an abandoned pending signature is removed. */
+const unsigned int   COMPLETED_SIGNATURE_RETENTION = 86400;                      /**< Default number of seconds for which a completed signature is kept. */
 
 // Step-out Group Signature scheme's specific constants:
 const std::size_t    ALPHA                      = 12;
@@ -39,16 +39,22 @@
 #include <boost/assign.hpp>
 #include <boost/bind.hpp>
 #include <boost/foreach.hpp>
+#include <boost/lexical_cast.hpp>
 
 #include <algorithm>
+#include <iostream>
 #include <iterator>
 #include <map>
 #include <sstream>
+#include <stdexcept>
 #include <utility>
 
 StepOutGroupSignaturesManager StepOutGroupSignaturesManager::sgs;
 
 StepOutGroupSignaturesManager::StepOutGroupSignaturesManager()
+    : signatureTimeout(0),
+      completionWork(completionService),
+      completionThread(boost::bind(&StepOutGroupSignaturesManager::runCompletionService, this))
 {
     initializeGroupZpValues();
     initializeKeyPair();
@@ -56,6 +62,12 @@ StepOutGroupSignaturesManager::StepOutGroupSignaturesManager()
     createDummyUserPrivateKey();
 }
 
+StepOutGroupSignaturesManager::~StepOutGroupSignaturesManager()
+{
+    completionService.stop();
+    completionThread.join();
+}
+
 BigInteger StepOutGroupSignaturesManager::calculateL(const BigInteger& t, const BigInteger& x)
 {
     Polynomial<SGS::L_POLYNOMIAL_DEGREE> lPolynomial;
@@ -107,29 +119,75 @@ BigInteger StepOutGroupSignaturesManager::calculateT(const BigInteger& x, const
 
 void StepOutGroupSignaturesManager::closeSignature(const CloseSignatureInput& input)
 {
-    bool closed = pendingSignaturesManager.closePendingSignature(input.getSignatureIndex(), input.getUserIndex());
+    PendingSignaturesManager::Access pendingSignature(pendingSignaturesManager, input.getSignatureIndex());
+    bool closed = pendingSignature->closeSignature(input.getUserIndex());
     if(closed)
     {
-        const BigInteger& t = pendingSignaturesManager.getPendingSignature(input.getSignatureIndex()).getT();
-        const std::size_t d = countSigners(input.getSignatureIndex());
+        const BigInteger& t = pendingSignature->getT();
+        const std::size_t d = countSigners(*pendingSignature);
         // generate r from Zq at random
         BigInteger::RandomGenerator randomGenerator(SGS::COEFFICIENTS_NBITS);
         BigInteger r = randomGenerator() % groupZpValues.q;
         Delta delta = createDelta(t, d, r);
-        const BigInteger& x = pendingSignaturesManager.getPendingSignature(input.getSignatureIndex()).getX();
+        const BigInteger& x = pendingSignature->getX();
         C c = createC(t, x , r);
-        std::string Z = createZ(input.getSignatureIndex());
-        std::string h = createH(pendingSignaturesManager.getPendingSignature(input.getSignatureIndex()).getMessage(), Z);
+        std::string Z = createZ(*pendingSignature);
+        std::string h = createH(pendingSignature->getMessage(), Z);
         Sigma sigma = createSigma(c, delta, h);
-        pendingSignaturesManager.getPendingSignature(input.getSignatureIndex()).setDelta(delta);
-        pendingSignaturesManager.getPendingSignature(input.getSignatureIndex()).setC(c);
-        pendingSignaturesManager.getPendingSignature(input.getSignatureIndex()).setSigma(sigma);
+        pendingSignature->setDelta(delta);
+        pendingSignature->setC(c);
+        pendingSignature->setSigma(sigma);
+    }
+}
+
+void StepOutGroupSignaturesManager::completeSignature(const unsigned int signatureIndex)
+{
+    try
+    {
+        PendingSignaturesManager::Access pendingSignature(pendingSignaturesManager, signatureIndex);
+        CompletedSignaturesStore::SerializedSignature signature =
+            createCompletedSignature(signatureIndex, *pendingSignature);
+        if(signature)
+            completedSignatures.insert(signatureIndex, signature);
+        else
+            completedSignatures.markFailed(signatureIndex);
+        pendingSignature.retire();
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << "Signature " << signatureIndex << " not completed: " << e.what() << std::endl;
     }
 }
 
-const std::size_t StepOutGroupSignaturesManager::countSigners(const unsigned int signatureIndex)
+const std::size_t StepOutGroupSignaturesManager::countSigners(const PendingSignature& pendingSignature)
 {
-    return pendingSignaturesManager.getPendingSignature(signatureIndex).getSignersXtValues().size();
+    return pendingSignature.getSignersXtValues().size();
+}
+
+CompletedSignaturesStore::SerializedSignature StepOutGroupSignaturesManager::createCompletedSignature(
+    const unsigned int signatureIndex,
+    const PendingSignature& pendingSignature)
+{
+    using namespace boost::assign;
+    try
+    {
+        const std::map<unsigned int, ThetaPrimElement>& signersThetaPrimElements =
+            pendingSignature.getSignersThetaPrimElements();
+        ThetaPrim thetaPrim;
+        for(std::map<unsigned int, ThetaPrimElement>::const_iterator it = signersThetaPrimElements.begin();
+            it != signersThetaPrimElements.end();
+            ++it)
+        {
+            thetaPrim += it->second;
+        }
+        return CompletedSignaturesStore::SerializedSignature(
+            new std::string(createSerializedSignature(pendingSignature, thetaPrim)));
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << "Signature " << signatureIndex << " not completed: " << e.what() << std::endl;
+        return CompletedSignaturesStore::SerializedSignature();
+    }
 }
 
 C StepOutGroupSignaturesManager::createC(const BigInteger& t, const BigInteger& x, const BigInteger& r)
@@ -173,10 +231,10 @@ void StepOutGroupSignaturesManager::createDummyUserXPolynomial()
 
 FinalizeSignatureInput StepOutGroupSignaturesManager::createFinalizeSignatureInput(const unsigned int signatureIndex)
 {
-    const PendingSignature& pendingSignature = pendingSignaturesManager.getPendingSignature(signatureIndex);
-    return FinalizeSignatureInput(pendingSignature.getT(),
-                                  pendingSignature.getC().gr(),
-                                  pendingSignature.getC().rSt());
+    PendingSignaturesManager::Access pendingSignature(pendingSignaturesManager, signatureIndex);
+    return FinalizeSignatureInput(pendingSignature->getT(),
+                                  pendingSignature->getC().gr(),
+                                  pendingSignature->getC().rSt());
 }
 
 std::string StepOutGroupSignaturesManager::createH(const std::string& message, const std::string& Z)
@@ -186,6 +244,30 @@ std::string StepOutGroupSignaturesManager::createH(const std::string& message, c
     return hasher.getHexHash();
 }
 
+ParametersBundle StepOutGroupSignaturesManager::createParametersBundle(const std::string& parameters) const
+{
+    SHA256 hasher;
+    hasher.setText(ParametersBundle::createSignedText(ParametersBundle::VERSION, parameters));
+    Sigma sigma = DigitalSignatureManager::sign(hasher.getHash(),
+                                                hasher.getHashLength(),
+                                                keyPair->getPrivateKey());
+    return ParametersBundle(ParametersBundle::VERSION, parameters, sigma);
+}
+
+std::string StepOutGroupSignaturesManager::createSerializedSignature(
+    const PendingSignature& pendingSignature,
+    const ThetaPrim& thetaPrim)
+{
+    return Utils::createBinaryString(Signature(
+        pendingSignature.getT(),
+        pendingSignature.getX(),
+        pendingSignature.getDelta(),
+        thetaPrim,
+        pendingSignature.getC(),
+        pendingSignature.getSigma()),
+        getElementWidth());
+}
+
 Sigma StepOutGroupSignaturesManager::createSigma(const C& c, const Delta& delta, const std::string& h)
 {
     std::string strC = Utils::createString(c);
@@ -198,10 +280,9 @@ Sigma StepOutGroupSignaturesManager::createSigma(const C& c, const Delta& delta,
     return sigma;
 }
 
-std::string StepOutGroupSignaturesManager::createZ(const unsigned int signatureIndex)
+std::string StepOutGroupSignaturesManager::createZ(const PendingSignature& pendingSignature)
 {
     using namespace boost::assign;
-    const PendingSignature& pendingSignature = pendingSignaturesManager.getPendingSignature(signatureIndex);
     const std::map<unsigned int, BigInteger>& signersXtValues = pendingSignature.getSignersXtValues();
     std::vector<BigInteger> xtValues;
     for(std::map<unsigned int, BigInteger>::const_iterator it = signersXtValues.begin();
@@ -241,22 +322,30 @@ void StepOutGroupSignaturesManager::finalizeSignature(
     const unsigned int signatureIndex,
     const FinalizeSignatureOutput& output)
 {
-    using namespace boost::assign;
-    PendingSignature& pendingSignature = pendingSignaturesManager.getPendingSignature(signatureIndex);
-    pendingSignature.finalizeSignature(output.getUserIndex(), output.getThetaPrimElement());
-    if(pendingSignature.getSignersXtValues().size() == pendingSignature.getSignersThetaPrimElements().size())
+    PendingSignaturesManager::Access pendingSignature(pendingSignaturesManager, signatureIndex);
+    pendingSignature->finalizeSignature(output.getUserIndex(), output.getThetaPrimElement());
+    if(hasAllThetaPrimElements(*pendingSignature) && pendingSignature.beginCompletion())
+        completionService.post(boost::bind(&StepOutGroupSignaturesManager::completeSignature, this, signatureIndex));
+}
+
+boost::optional<PublishedValues> StepOutGroupSignaturesManager::findPublishedValues(
+    const CheckProcedureInput& input) const
+{
+    return publishedUsersSecrets.find(input.getUserIndex(), input.getT());
+}
+
+std::vector<std::pair<unsigned int, PublishedValues> > StepOutGroupSignaturesManager::findAllPublishedValues(
+    const BigInteger& t) const
+{
+    std::vector<std::pair<unsigned int, PublishedValues> > usersPublishedValues = publishedUsersSecrets.findAll(t);
+    std::vector<std::pair<unsigned int, PublishedValues> > registeredUsersPublishedValues;
+    registeredUsersPublishedValues.reserve(usersPublishedValues.size());
+    for(std::size_t i = 0; i < usersPublishedValues.size(); ++i)
     {
-        const std::map<unsigned int, ThetaPrimElement>& signersThetaPrimElements =
-            pendingSignature.getSignersThetaPrimElements();
-        ThetaPrim thetaPrim;
-        for(std::map<unsigned int, ThetaPrimElement>::const_iterator it = signersThetaPrimElements.begin();
-            it != signersThetaPrimElements.end();
-            ++it)
-        {
-            thetaPrim += it->second;
-        }
-        pendingSignature.setThetaPrim(thetaPrim);
+        if(usersPublicKeys.contains(usersPublishedValues[i].first))
+            registeredUsersPublishedValues.push_back(usersPublishedValues[i]);
     }
+    return registeredUsersPublishedValues;
 }
 
 const UserPrivateKey& StepOutGroupSignaturesManager::getDummyUserPrivateKey()
@@ -264,22 +353,14 @@ const UserPrivateKey& StepOutGroupSignaturesManager::getDummyUserPrivateKey()
     return *dummyUserPrivateKey;
 }
 
-const GroupZpValues& StepOutGroupSignaturesManager::getGroupZpValues() const
+std::size_t StepOutGroupSignaturesManager::getElementWidth() const
 {
-    return groupZpValues;
+    return groupZpValues.p.getNumberOfBytes();
 }
 
-const PublishedValues& StepOutGroupSignaturesManager::getPublishedValues(const CheckProcedureInput& input)
+const GroupZpValues& StepOutGroupSignaturesManager::getGroupZpValues() const
 {
-    const unsigned int userIndex = input.getUserIndex();
-    const BigInteger& t = input.getT();
-    BOOST_ASSERT(publishedUsersSecrets.count(userIndex));
-    BOOST_FOREACH(const PublishedValues& publishedValues, publishedUsersSecrets[userIndex])
-    {
-        if(publishedValues.getT() == t)
-            return publishedValues;
-    }
-    BOOST_ASSERT(0);
+    return groupZpValues;
 }
 
 const RSAKey& StepOutGroupSignaturesManager::getServerPublicKey() const
@@ -287,41 +368,49 @@ const RSAKey& StepOutGroupSignaturesManager::getServerPublicKey() const
     return dynamic_cast<const RSAKey&>(keyPair->getPublicKey());
 }
 
-Signature StepOutGroupSignaturesManager::getSignature(const unsigned int signatureIndex)
+CompletedSignaturesStore::SerializedSignature StepOutGroupSignaturesManager::getSignature(
+    const unsigned int signatureIndex)
 {
-    const PendingSignature& pendingSignature = pendingSignaturesManager.getPendingSignature(signatureIndex);
-    return Signature(
-        pendingSignature.getT(),
-        pendingSignature.getX(),
-        pendingSignature.getDelta(),
-        pendingSignature.getThetaPrim(),
-        pendingSignature.getC(),
-        pendingSignature.getSigma());
+    CompletedSignaturesStore::SerializedSignature signature = completedSignatures.find(signatureIndex);
+    if(signature)
+        return signature;
+    try
+    {
+        PendingSignaturesManager::Access pendingSignature(pendingSignaturesManager, signatureIndex);
+        if(!hasAllThetaPrimElements(*pendingSignature))
+        {
+            return CompletedSignaturesStore::SerializedSignature(
+                new std::string(createSerializedSignature(*pendingSignature, pendingSignature->getThetaPrim())));
+        }
+    }
+    catch(std::runtime_error&)
+    {
+        // the signature might have been completed in the meantime
+        signature = completedSignatures.find(signatureIndex);
+        if(!signature)
+            throw;
+        return signature;
+    }
+    return completedSignatures.waitFor(signatureIndex, boost::posix_time::seconds(signatureTimeout.load()));
 }
 
 BigInteger StepOutGroupSignaturesManager::getTFromPendingSignature(const unsigned int signatureIndex)
 {
-    return pendingSignaturesManager.getPendingSignature(signatureIndex).getT();
+    PendingSignaturesManager::Access pendingSignature(pendingSignaturesManager, signatureIndex);
+    return pendingSignature->getT();
 }
 
 const UserPublicKey& StepOutGroupSignaturesManager::getUserPublicKey(const unsigned int userIndex) const
 {
-    BOOST_ASSERT(userIndex < usersPublicKeys.size());
+    if(!usersPublicKeys.contains(userIndex))
+        throw std::runtime_error("User " + boost::lexical_cast<std::string>(userIndex) + " is not registered!");
     return usersPublicKeys[userIndex];
 }
 
-bool StepOutGroupSignaturesManager::hasPublishedValues(const CheckProcedureInput& input)
+bool StepOutGroupSignaturesManager::hasAllThetaPrimElements(const PendingSignature& pendingSignature)
 {
-    const unsigned int userIndex = input.getUserIndex();
-    const BigInteger& t = input.getT();
-    if(publishedUsersSecrets.count(userIndex) == 0)
-        return false;
-    BOOST_FOREACH(const PublishedValues& publishedValues, publishedUsersSecrets[userIndex])
-    {
-        if(publishedValues.getT() == t)
-            return true;
-    }
-    return false;
+    return (!pendingSignature.getSignersThetaPrimElements().empty() &&
+            pendingSignature.getSignersThetaPrimElements().size() == pendingSignature.getSignersXtValues().size());
 }
 
 void StepOutGroupSignaturesManager::initializeGroup()
@@ -365,9 +454,17 @@ unsigned int StepOutGroupSignaturesManager::initializeSignature(const Initialize
     const std::string& message = input.getMessage();
     const BigInteger& x = input.getX();
     BigInteger t = calculateT(x, message);
+    BOOST_FOREACH(const unsigned int expiredSignatureIndex, pendingSignaturesManager.expirePendingSignatures())
+        completedSignatures.erase(expiredSignatureIndex);
     return pendingSignaturesManager.addPendingSignature(userIndex, message, t, x);
 }
 
+bool StepOutGroupSignaturesManager::isMessageDigest(const std::string& message) const
+{
+    return (message.size() == SGS::MESSAGE_DIGEST_LENGTH &&
+            message.find_first_not_of("0123456789abcdef") == std::string::npos);
+}
+
 StepOutGroupSignaturesManager& StepOutGroupSignaturesManager::instance()
 {
     return sgs;
@@ -378,9 +475,11 @@ void StepOutGroupSignaturesManager::joinSignature(const unsigned int signatureIn
     pendingSignaturesManager.addUserToPendingSignature(signatureIndex, input.getUserIndex(), input.getXt());
 }
 
-void StepOutGroupSignaturesManager::publish(const PublishProcedureInput& input)
+bool StepOutGroupSignaturesManager::publish(const PublishProcedureInput& input)
 {
-    publishedUsersSecrets[input.getUserIndex()].insert(input.getPublishedValues());
+    if(!usersPublicKeys.contains(input.getUserIndex()))
+        return false;
+    return publishedUsersSecrets.insert(input.getUserIndex(), input.getPublishedValues(), groupZpValues.q);
 }
 
 void StepOutGroupSignaturesManager::initializeAPolynomials()
@@ -403,8 +502,22 @@ void StepOutGroupSignaturesManager::randomizePolynomial(Polynomial<D>& p_poly)
 
 std::size_t StepOutGroupSignaturesManager::registerNewUser(const UserPublicKey& p_userPublicKey)
 {
-    usersPublicKeys.push_back(p_userPublicKey);
-    return usersPublicKeys.size() - 1;
+    return usersPublicKeys.append(p_userPublicKey);
+}
+
+void StepOutGroupSignaturesManager::runCompletionService()
+{
+    completionService.run();
+}
+
+void StepOutGroupSignaturesManager::setSignatureRetention(const long seconds)
+{
+    pendingSignaturesManager.setRetentionPeriod(seconds);
+}
+
+void StepOutGroupSignaturesManager::setSignatureTimeout(const long seconds)
+{
+    signatureTimeout.store(seconds);
 }
 
 SignProcedureOutput StepOutGroupSignaturesManager::sign(const BigInteger& t,
@@ -34,6 +34,7 @@
 #ifndef STEPOUTGROUPSIGNATURESMANAGER_HPP
 #define	STEPOUTGROUPSIGNATURESMANAGER_HPP
 
+#include "../concurrent/SegmentedTable.hpp"
 #include "../key/IKeyPair.hpp"
 #include "../key/RSAKey.hpp"
 #include "../mpi/BigInteger.hpp"
@@ -41,18 +42,22 @@
 #include "C.hpp"
 #include "CheckProcedureInput.hpp"
 #include "CloseSignatureInput.hpp"
+#include "CompletedSignaturesStore.hpp"
 #include "Delta.hpp"
 #include "FinalizeSignatureInput.hpp"
 #include "FinalizeSignatureOutput.hpp"
 #include "GroupZpValues.hpp"
 #include "InitializeSignatureInput.hpp"
 #include "JoinSignatureInput.hpp"
+#include "ParametersBundle.hpp"
 #include "PendingSignaturesManager.hpp"
 #include "PublishedValues.hpp"
+#include "PublishedValuesStore.hpp"
 #include "PublishProcedureInput.hpp"
 #include "PQPolynomials.hpp"
 #include "Sigma.hpp"
 #include "Signature.hpp"
+#include "ThetaPrim.hpp"
 #include "SignProcedureInput.hpp"
 #include "SignProcedureOutput.hpp"
 #include "StepOutGroupSignaturesConstants.hpp"
@@ -60,12 +65,16 @@
 #include "UserPublicKey.hpp"
 
 #include <boost/array.hpp>
+#include <boost/asio.hpp>
+#include <boost/atomic.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+#include <boost/thread/thread.hpp>
 
 #include <cstddef>
 #include <map>
-#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 /**
@@ -75,10 +84,23 @@
  * managiement. It implements all methods needed by scheme
  * procedures such as signing, publishing, checking
  * or validating a signature.
+ *
+ * The only instance is shared by all sessions' threads.
+ * Registered users' keys, pending signatures and published
+ * values are kept in concurrent stores, and every pending
+ * signature is guarded by its own mutex, so sessions working
+ * on different data do not serialize each other.
  */
 class StepOutGroupSignaturesManager : private boost::noncopyable
 {
 public:
+    /**
+     * Destructor of the StepOutGroupSignaturesManager class.
+     *
+     * Stops the thread which completes signatures in the background.
+     */
+    ~StepOutGroupSignaturesManager();
+
     /**
      * Calculates polynomials P(t) and Q(t)
      * based on a given x(t) polynomial.
@@ -99,6 +121,16 @@ public:
      */
     FinalizeSignatureInput createFinalizeSignatureInput(const unsigned int signatureIndex);
 
+    /**
+     * Signs serialized group parameters with the server's private key.
+     *
+     * @param parameters Serialized group values, the server's public key
+     *                   and the dummy user's private key.
+     *
+     * @return Bundle of the parameters and their signature.
+     */
+    ParametersBundle createParametersBundle(const std::string& parameters) const;
+
     /**
      * Closes a signature of a particular index number.
      *
@@ -107,7 +139,8 @@ public:
     void closeSignature(const CloseSignatureInput& input);
 
     /**
-     * Performs FinalizeSignature procedure.
+     * Performs FinalizeSignature procedure. When shares of all signers
+     * have arrived, the signature is completed in the background.
      *
      * @param signatureIndex Index number of a signature to be finalized.
      *
@@ -115,6 +148,28 @@ public:
      */
     void finalizeSignature(const unsigned int signatureIndex, const FinalizeSignatureOutput& output);
 
+    /**
+     * Returns published user's data needed to perform
+     * Check procedure.
+     *
+     * @param input Object containing user's index number and value t.
+     *
+     * @return Published user's data if the user has published it. Nothing otherwise.
+     */
+    boost::optional<PublishedValues> findPublishedValues(const CheckProcedureInput& input) const;
+
+    /**
+     * Returns data published by all users for a given signature,
+     * needed to check all of them at once.
+     *
+     * Data published under index numbers of unregistered users is skipped.
+     *
+     * @param t Value t of the signature.
+     *
+     * @return Users' index numbers and their published data.
+     */
+    std::vector<std::pair<unsigned int, PublishedValues> > findAllPublishedValues(const BigInteger& t) const;
+
     /**
      * Returns the dummy user's private key.
      *
@@ -123,21 +178,19 @@ public:
     const UserPrivateKey& getDummyUserPrivateKey();
 
     /**
-     * Return group specific values (p, q and g).
+     * Returns the number of bytes of elements of the group,
+     * i.e. of p, with which they are sent to clients.
      *
-     * @return Group specific values.
+     * @return Number of bytes of group elements.
      */
-    const GroupZpValues& getGroupZpValues() const;
+    std::size_t getElementWidth() const;
 
     /**
-     * Returns published user's data needed to perform
-     * Check procedure.
-     *
-     * @param inputObject containing user's index number and value t.
+     * Return group specific values (p, q and g).
      *
-     * @return Published user's data.
+     * @return Group specific values.
      */
-    const PublishedValues& getPublishedValues(const CheckProcedureInput& input);
+    const GroupZpValues& getGroupZpValues() const;
 
     /**
      * Returns Group Privacy Server's public key.
@@ -148,12 +201,19 @@ public:
 
     /**
      * Returns step-out group signature of a given index number.
+     * If shares of all signers have arrived, waits until the signature
+     * is completed, but not longer than the time set by setSignatureTimeout().
+     * A signature that is still missing shares is serialized as it is.
+     * Completed signatures are kept for the time set by setSignatureRetention().
      *
      * @param signatureIndex Index number of the signature.
      *
-     * @return Step-out group signature.
+     * @return Serialized step-out group signature.
+     *
+     * @throw std::runtime_error If there is no such signature, it couldn't be completed
+     *                           or it hasn't been completed in time.
      */
-    Signature getSignature(const unsigned int signatureIndex);
+    CompletedSignaturesStore::SerializedSignature getSignature(const unsigned int signatureIndex);
 
     /**
      * Returns \c t value from signature of a given index number.
@@ -170,27 +230,30 @@ public:
      * @param userIndex Index number of the user.
      *
      * @return User's public key.
+     *
+     * @throw std::runtime_error If there is no such user.
      */
     const UserPublicKey& getUserPublicKey(const unsigned int userIndex) const;
 
     /**
-     * Checks whether a user has published data
-     * needed to perform Check procedure.
+     * Creates a new pending signature with open status.
      *
-     * @param input Object containing user's index number and value t.
+     * @param input Object containing user's index, message to sign and value x.
      *
-     * @return True if the user has published the data. False otherwise.
+     * @return Unique signature's number.
      */
-    bool hasPublishedValues(const CheckProcedureInput& input);
+    unsigned int initializeSignature(const InitializeSignatureInput& input);
 
     /**
-     * Creates a new pending signature with open status.
+     * Checks whether a given message is a digest of a message
+     * as created by Group Privacy Client in digest only mode.
      *
-     * @param input Object containing user's index, message to sign and value x.
+     * @param message Message to check.
      *
-     * @return Unique signature's number.
+     * @return True if the message consists of \c SGS::MESSAGE_DIGEST_LENGTH
+     *         hexadecimal digits. False otherwise.
      */
-    unsigned int initializeSignature(const InitializeSignatureInput& input);
+    bool isMessageDigest(const std::string& message) const;
 
     /**
      * Return the only instance of the \c StepOutGroupSignaturesManager class.
@@ -208,10 +271,13 @@ public:
 
     /**
      * Published user's data needed to perform Check procedure.
+     * Data of users who aren't registered is rejected.
      *
      * @param input Object containing user's data.
+     *
+     * @return False if the data has been rejected. True otherwise.
      */
-    void publish(const PublishProcedureInput& input);
+    bool publish(const PublishProcedureInput& input);
 
     /**
      * Registers a new user in the group.
@@ -230,21 +296,43 @@ public:
      * @return Calculated necessary data to finish the Sign procedure.
      */
     SignProcedureOutput sign(const SignProcedureInput& input);
+
+    /**
+     * Sets the time for which completed signatures are kept. Their index
+     * numbers aren't reused in the meantime. Signatures completed before
+     * the call keep their previous retention.
+     *
+     * @param seconds Number of seconds. Zero if signatures are kept for the lifetime of the server,
+     *                which limits the number of all signatures to the number of handles.
+     */
+    void setSignatureRetention(const long seconds);
+
+    /**
+     * Sets the maximal time of waiting for a signature to be completed.
+     *
+     * @param seconds Number of seconds. Zero if there is no limit.
+     */
+    void setSignatureTimeout(const long seconds);
 private:
     StepOutGroupSignaturesManager();
     BigInteger calculateL(const BigInteger& t, const BigInteger& x);
     Polynomial<SGS::P_POLYNOMIAL_DEGREE> calculatePPolynomial(const Polynomial<SGS::X_POLYNOMIAL_DEGREE>& x);
     Polynomial<SGS::Q_POLYNOMIAL_DEGREE> calculateQPolynomial(const Polynomial<SGS::X_POLYNOMIAL_DEGREE>& x);
     BigInteger calculateT(const BigInteger& x, const std::string& message);
-    const std::size_t countSigners(const unsigned int signatureIndex);
+    void completeSignature(const unsigned int signatureIndex);
+    CompletedSignaturesStore::SerializedSignature createCompletedSignature(const unsigned int signatureIndex,
+                                                                           const PendingSignature& pendingSignature);
+    const std::size_t countSigners(const PendingSignature& pendingSignature);
     C createC(const BigInteger& t, const BigInteger& x, const BigInteger& r);
     Delta createDelta(const BigInteger& t, const std::size_t d, const BigInteger& r);
     void createDummyUserPrivateKey();
     void createDummyUserXPolynomial();
     std::string createH(const std::string& message, const std::string& Z);
+    std::string createSerializedSignature(const PendingSignature& pendingSignature, const ThetaPrim& thetaPrim);
     Sigma createSigma(const C& c, const Delta& delta, const std::string& h);
-    std::string createZ(const unsigned int signatureIndex);
+    std::string createZ(const PendingSignature& pendingSignature);
     Polynomial<SGS::L_EXP_POLYNOMIAL_DEGREE> expandLPolynomial(const Polynomial<SGS::X_POLYNOMIAL_DEGREE>& x);
+    bool hasAllThetaPrimElements(const PendingSignature& pendingSignature);
     void initializeGroup();
     void initializeGroupZpValues();
     void initializeKeyPair();
@@ -254,6 +342,7 @@ private:
     void initializeSPolynomial();
     template<std::size_t D>
     void randomizePolynomial(Polynomial<D>& p_poly);
+    void runCompletionService();
     SignProcedureOutput sign(const BigInteger& t, const BigInteger& x, const std::size_t d, const std::string& h);
 
     static StepOutGroupSignaturesManager                 sgs;
@@ -264,9 +353,14 @@ private:
     boost::array<Polynomial<SGS::A_POLYNOMIAL_DEGREE>,
                  SGS::NUMBER_OF_A_POLYNOMIALS>           aPolys;
     Polynomial<SGS::S_POLYNOMIAL_DEGREE>                 sPoly;
-    std::vector<UserPublicKey>                           usersPublicKeys;
-    std::map<unsigned int, std::set<PublishedValues> >   publishedUsersSecrets;
+    SegmentedTable<UserPublicKey>                        usersPublicKeys;
+    PublishedValuesStore                                 publishedUsersSecrets;
     PendingSignaturesManager                             pendingSignaturesManager;
+    CompletedSignaturesStore                             completedSignatures;
+    boost::atomic<long>                                  signatureTimeout;    /**< Seconds getSignature() waits for completion. */
+    boost::asio::io_service                              completionService;   /**< Completes signatures in the background. */
+    boost::asio::io_service::work                        completionWork;
+    boost::thread                                        completionThread;
 };
 
 #endif // STEPOUTGROUPSIGNATURESMANAGER_HPP
@@ -28,8 +28,11 @@
 #ifndef UTILS_HPP
 #define	UTILS_HPP
 
+#include "../serialization/BinaryOArchive.hpp"
+
 #include <boost/archive/text_oarchive.hpp>
 
+#include <cstddef>
 #include <sstream>
 #include <string>
 
@@ -45,6 +48,23 @@ std::string createString(const Serializable& serializable)
     return ss.str();
 }
 
+/**
+ * Serializes a given object in the compact binary format
+ * used by the protocol.
+ *
+ * @param serializable Object to serialize.
+ * @param elementWidth Number of bytes of group elements.
+ * @return String containing the serialized object.
+ */
+template<typename Serializable>
+std::string createBinaryString(const Serializable& serializable, const std::size_t elementWidth = 0)
+{
+    std::string binary;
+    BinaryOArchive oa(binary, elementWidth);
+    oa << serializable;
+    return binary;
+}
+
 } // namespace Utils
 
 #endif // UTILS_HPP